@@ -3,5 +3,17 @@
 
 #include "singly.h"
 #include "circulardoublylinked.h"
+#include "staticlist.h"
+#include "tracedlist.h"
+#include "listviews.h"
+#include "timerwheel.h"
+#include "persistentlist.h"
+#include "rculist.h"
+#include "chunkedlist.h"
+#include "intrusivelist.h"
+#include "handlelist.h"
+#include "listchannel.h"
+#include "bloomlist.h"
+#include "augmentedlist.h"
 
 #endif
\ No newline at end of file
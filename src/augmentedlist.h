@@ -0,0 +1,355 @@
+#ifndef AUGMENTED_LIST_H
+#define AUGMENTED_LIST_H
+
+#include <Arduino.h>
+#include "circulardoublylinked.h"
+#include "listkey.h"
+#include "listsimd.h"
+#include "observedlist.h"
+
+/// @brief aggregate policy: sum and count of the payload keys, so the mean is O(1)
+/// @details An aggregate policy names value_type and provides identity(),
+/// lift(payload), combine(a, b) and uncombine(total, part), where uncombine
+/// undoes a combine so deletes are O(1) too; value_type with combine must form
+/// a group. Sums are kept in int64_t, or double for floating-point keys.
+/// @tparam Key key policy with key_type and key(payload), see listkey
+template <typename Key>
+struct sumaggregate
+{
+    typedef typename simdsum<typename Key::key_type>::type sum_type; ///< accumulator type
+
+    /// @brief sum and count of the keys
+    struct value_type
+    {
+        sum_type sum; ///< total of the keys
+        size_t count; ///< number of payloads
+
+        /// @brief mean of the keys, 0 if there are none
+        double mean() const
+        {
+            return count > 0U ? (double)sum / (double)count : 0.0;
+        }
+    };
+
+    static value_type identity()
+    {
+        value_type none = {0, 0U};
+        return none;
+    }
+
+    template <typename T>
+    static value_type lift(const T &payload)
+    {
+        value_type one = {(sum_type)Key::key(payload), 1U};
+        return one;
+    }
+
+    static value_type combine(const value_type &a, const value_type &b)
+    {
+        value_type both = {a.sum + b.sum, a.count + b.count};
+        return both;
+    }
+
+    static value_type uncombine(const value_type &total, const value_type &part)
+    {
+        value_type rest = {total.sum - part.sum, total.count - part.count};
+        return rest;
+    }
+};
+
+/// @brief observer of an augmentedlist: folds every payload into one aggregate
+template <typename Aggregate>
+struct aggregateobserver
+{
+    aggregateobserver() : total(Aggregate::identity()) {}
+
+    template <typename T>
+    void added(const T &payload, listedge)
+    {
+        total = Aggregate::combine(total, Aggregate::lift(payload));
+    }
+
+    template <typename T>
+    void removed(const T &payload, listedge)
+    {
+        total = Aggregate::uncombine(total, Aggregate::lift(payload));
+    }
+
+    void cleared()
+    {
+        total = Aggregate::identity();
+    }
+
+    void reordered() {}
+
+    typename Aggregate::value_type total; ///< aggregate of every payload in the list
+};
+
+/// @brief list wrapper keeping an aggregate of its payloads up to date
+/// @details An observedlist whose observer combines each inserted payload into
+/// the aggregate and uncombines each deleted one, so aggregate() is O(1) and
+/// every insert and delete pays one combine. Lists that are not wrapped pay
+/// nothing. Payloads changed in place need rebuild().
+/// @tparam List singlylist, circulardoublylist or any basic_ variant
+/// @tparam Aggregate aggregate policy, e.g. sumaggregate<listkey<int>>
+template <typename List, typename Aggregate>
+class augmentedlist : public observedlist<List, aggregateobserver<Aggregate>>
+{
+public:
+    typedef typename Aggregate::value_type aggregate_type; ///< type returned by aggregate()
+
+    using observedlist<List, aggregateobserver<Aggregate>>::operator=;
+
+    /// @brief gets the aggregate of every payload in O(1)
+    /// @return Aggregate::identity() if the list is empty
+    const aggregate_type &aggregate() const
+    {
+        return this->observer.total;
+    }
+};
+
+/// @brief keys that can still become the smallest (or, with Largest, the largest) payload key
+/// @details Holds, in list order, each key that no later key beats, so the
+/// front is the extreme. Appending pops the beaten keys off the back; removing
+/// the head pops the front if it was the head's key. Both are O(1) amortised.
+/// Other changes may leave the wedge unable to tell, which marks it stale.
+template <typename T, bool Largest>
+class monotonicwedge
+{
+public:
+    monotonicwedge() : stale(false) {}
+
+    void pushBack(const T &key)
+    {
+        while (keys.size() > 0 && beats(key, *keys.getStoragePtr(keys.size())))
+        {
+            keys.deleteFromPosition(keys.size());
+        }
+        append(key);
+    }
+
+    void pushFront(const T &key)
+    {
+        if (keys.size() == 0 || !beats(*keys.getStoragePtr(1), key))
+        {
+            if (keys.insertAtBeginning(key) == nullptr)
+            {
+                stale = true;
+            }
+        }
+    }
+
+    void insertInside(const T &key)
+    {
+        if (keys.size() == 0 || !beats(*keys.getStoragePtr(keys.size()), key))
+        {
+            stale = true; // key may join the wedge or beat keys in it
+        }
+    }
+
+    void popFront(const T &key)
+    {
+        if (keys.size() > 0 && same(*keys.getStoragePtr(1), key))
+        {
+            keys.deleteFromPosition(1);
+        }
+    }
+
+    void popBack()
+    {
+        keys.deleteFromPosition(keys.size());
+        stale = true; // keys before the old tail may now be unbeaten
+    }
+
+    void eraseInside(const T &key)
+    {
+        if (stale)
+        {
+            return;
+        }
+        for (auto it = keys.begin(); it != keys.end(); ++it)
+        {
+            if (same(*it, key))
+            {
+                stale = true; // the erased payload may have been this wedge key
+                return;
+            }
+        }
+    }
+
+    void clear()
+    {
+        keys.clear();
+        stale = false;
+    }
+
+    /// @brief marks the wedge for a rebuild, e.g. after the list was reordered
+    void markStale() { stale = true; }
+
+    bool isStale() const { return stale; }
+
+    /// @brief gets the extreme key
+    /// @return false if the wedge is empty
+    bool front(T &result)
+    {
+        if (keys.size() == 0)
+        {
+            return false;
+        }
+        result = *keys.getStoragePtr(1);
+        return true;
+    }
+
+    /// @brief checks whether a ranks strictly before b
+    static bool beats(const T &a, const T &b)
+    {
+        return Largest ? b < a : a < b;
+    }
+
+private:
+    static bool same(const T &a, const T &b)
+    {
+        return !(a < b) && !(b < a);
+    }
+
+    void append(const T &key)
+    {
+        if (keys.insertAtEnd(key) == nullptr)
+        {
+            stale = true;
+        }
+    }
+
+    basic_circulardoublylist<slabtraits<8>, T, T> keys; ///< unbeaten keys in list order; slabs keep freed slots
+    bool stale;                                         ///< set when the keys may no longer match the list
+};
+
+/// @brief observer of an extremalist: one wedge for the minimum, one for the maximum
+template <typename Key>
+struct extremaobserver
+{
+    typedef typename Key::key_type key_type;
+
+    template <typename T>
+    void added(const T &payload, listedge edge)
+    {
+        const key_type &key = Key::key(payload);
+        if (edge == EDGE_BACK)
+        {
+            smallest.pushBack(key);
+            largest.pushBack(key);
+        }
+        else if (edge == EDGE_FRONT)
+        {
+            smallest.pushFront(key);
+            largest.pushFront(key);
+        }
+        else
+        {
+            smallest.insertInside(key);
+            largest.insertInside(key);
+        }
+    }
+
+    template <typename T>
+    void removed(const T &payload, listedge edge)
+    {
+        const key_type &key = Key::key(payload);
+        if (edge == EDGE_FRONT)
+        {
+            smallest.popFront(key);
+            largest.popFront(key);
+        }
+        else if (edge == EDGE_BACK)
+        {
+            smallest.popBack();
+            largest.popBack();
+        }
+        else
+        {
+            smallest.eraseInside(key);
+            largest.eraseInside(key);
+        }
+    }
+
+    void cleared()
+    {
+        smallest.clear();
+        largest.clear();
+    }
+
+    void reordered()
+    {
+        smallest.markStale();
+        largest.markStale();
+    }
+
+    monotonicwedge<key_type, false> smallest; ///< candidates for min()
+    monotonicwedge<key_type, true> largest;   ///< candidates for max()
+};
+
+/// @brief list wrapper answering min() and max() of its payload keys without a walk
+/// @details An observedlist keeping two monotonic wedges: the keys that no
+/// later key beats, in list order. Appending at the tail and removing at the
+/// head keep them exact in O(1) amortised, which covers queues, FIFOs and
+/// sliding windows. Inserting at the head is O(1) too. Removing the tail, or
+/// removing or inserting in the middle where the wedge cannot tell whether it
+/// changed, marks it stale, as do reverse() and partition(); the next min() /
+/// max() then rebuilds both wedges in one O(n) pass.
+///
+/// The wedges live in slab-backed lists of keys, so in the worst case (keys
+/// sorted) one of them holds a key per payload. Payloads changed in place need
+/// rebuild(). Wrappers nest, e.g. extremalist<augmentedlist<List, Aggregate>, Key>.
+/// @tparam List singlylist, circulardoublylist or any basic_ variant
+/// @tparam Key key policy with key_type and key(payload), see listkey
+template <typename List, typename Key>
+class extremalist : public observedlist<List, extremaobserver<Key>>
+{
+public:
+    typedef typename Key::key_type key_type; ///< type returned by min() and max()
+
+    using observedlist<List, extremaobserver<Key>>::operator=;
+
+    /// @brief gets the smallest key, O(1) unless the wedge is stale
+    /// @param result set to the smallest key
+    /// @return false if the list is empty
+    bool min(key_type &result)
+    {
+        return extreme(this->observer.smallest, result);
+    }
+
+    /// @brief gets the largest key, O(1) unless the wedge is stale
+    /// @param result set to the largest key
+    /// @return false if the list is empty
+    bool max(key_type &result)
+    {
+        return extreme(this->observer.largest, result);
+    }
+
+private:
+    template <typename Wedge>
+    bool extreme(Wedge &wedge, key_type &result)
+    {
+        if (wedge.isStale())
+        {
+            this->rebuild();
+        }
+        if (!wedge.isStale())
+        {
+            return wedge.front(result);
+        }
+        bool found = false; // the wedge could not allocate: walk the list instead
+        for (auto it = List::begin(); it != List::end(); ++it)
+        {
+            const key_type &key = Key::key(*it);
+            if (!found || Wedge::beats(key, result))
+            {
+                result = key;
+                found = true;
+            }
+        }
+        return found;
+    }
+};
+
+#endif // AUGMENTED_LIST_H
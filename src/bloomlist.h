@@ -0,0 +1,198 @@
+#ifndef BLOOM_LIST_H
+#define BLOOM_LIST_H
+
+#include <Arduino.h>
+#include "listkey.h"
+#include "observedlist.h"
+
+/// @brief counting Bloom filter with Counters 4-bit counters
+/// @details An item sets Probes counters, picked from its 32-bit hash by
+/// double hashing. mayContain() is false only if the item was never added (or
+/// was removed as often as added), so a miss is usually rejected after Probes
+/// lookups. Removing decrements the same counters. A counter that reaches 15
+/// stays at 15, so an overflow can only cost false positives, never a false
+/// negative. The counters take Counters / 2 bytes.
+/// @tparam Counters number of counters, even; a power of two makes probing cheaper
+/// @tparam Probes counters per item, 1 to 8
+template <size_t Counters, uint8_t Probes = 3>
+class countingbloom
+{
+public:
+    static_assert(Counters >= 2 && Counters % 2 == 0, "countingbloom needs an even number of counters");
+    static_assert(Probes >= 1 && Probes <= 8, "countingbloom probes 1 to 8 counters per item");
+
+    countingbloom()
+    {
+        clear();
+    }
+
+    /// @brief counts an item
+    /// @param hash hash of the item
+    void add(uint32_t hash)
+    {
+        uint32_t step;
+        uint32_t at = first_probe(hash, step);
+        for (uint8_t i = 0; i < Probes; ++i, at += step)
+        {
+            size_t index = at % Counters;
+            uint8_t count = counter(index);
+            if (count < saturated)
+            {
+                set_counter(index, count + 1U);
+            }
+        }
+    }
+
+    /// @brief uncounts an item that was added
+    /// @param hash hash of the item
+    void remove(uint32_t hash)
+    {
+        uint32_t step;
+        uint32_t at = first_probe(hash, step);
+        for (uint8_t i = 0; i < Probes; ++i, at += step)
+        {
+            size_t index = at % Counters;
+            uint8_t count = counter(index);
+            if (count > 0U && count < saturated)
+            {
+                set_counter(index, count - 1U);
+            }
+        }
+    }
+
+    /// @brief checks whether an item may have been added
+    /// @param hash hash of the item
+    /// @return false if the item is certainly not counted
+    bool mayContain(uint32_t hash) const
+    {
+        uint32_t step;
+        uint32_t at = first_probe(hash, step);
+        for (uint8_t i = 0; i < Probes; ++i, at += step)
+        {
+            if (counter(at % Counters) == 0U)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief uncounts every item
+    void clear()
+    {
+        memset(counters, 0, sizeof(counters));
+    }
+
+private:
+    static const uint8_t saturated = 15U; ///< sticky counter value
+
+    /// @brief spreads the user hash and splits it into a start and an odd step
+    static uint32_t first_probe(uint32_t hash, uint32_t &step)
+    {
+        hash ^= hash >> 16; // murmur3 finaliser: every input bit moves every output bit
+        hash *= 0x85EBCA6BU;
+        hash ^= hash >> 13;
+        hash *= 0xC2B2AE35U;
+        hash ^= hash >> 16;
+        step = ((hash >> 17) | (hash << 15)) | 1U;
+        return hash;
+    }
+
+    uint8_t counter(size_t index) const
+    {
+        uint8_t pair = counters[index / 2U];
+        return index % 2U ? pair >> 4 : pair & 0x0FU;
+    }
+
+    void set_counter(size_t index, uint8_t count)
+    {
+        uint8_t &pair = counters[index / 2U];
+        pair = index % 2U ? (uint8_t)((pair & 0x0FU) | (count << 4)) : (uint8_t)((pair & 0xF0U) | count);
+    }
+
+    uint8_t counters[Counters / 2U]; ///< two 4-bit counters per byte
+};
+
+/// @brief observer of a bloomlist: counts the key of every payload in the filter
+template <typename Key, size_t Counters, uint8_t Probes>
+struct bloomobserver
+{
+    template <typename T>
+    void added(const T &payload, listedge)
+    {
+        filter.add(Key::hash(Key::key(payload)));
+    }
+
+    template <typename T>
+    void removed(const T &payload, listedge)
+    {
+        filter.remove(Key::hash(Key::key(payload)));
+    }
+
+    void cleared()
+    {
+        filter.clear();
+    }
+
+    void reordered() {}
+
+    countingbloom<Counters, Probes> filter; ///< counts the keys of the payloads
+};
+
+/// @brief list wrapper with a counting Bloom filter over its keys
+/// @details An observedlist whose observer counts every payload's key, so
+/// mayContain() rejects most keys that are not in the list in O(1) and
+/// contains() / find() walk the list only when the filter lets a key through.
+///
+/// Payloads changed in place (through getStoragePtr(), iterators or views)
+/// must keep their keys, or the filter must be rebuilt with rebuild(), since a
+/// changed key may be reported absent. Nodes spliced in from a plain list are
+/// counted; nodes spliced out to a plain list stay counted until rebuild().
+/// @tparam List singlylist, circulardoublylist or any basic_ variant
+/// @tparam Key key policy with key_type, key(payload) and hash(key), see listkey
+/// @tparam Counters filter counters (Counters / 2 bytes); about 8 per node keeps false positives near 3 %
+/// @tparam Probes counters per key
+template <typename List, typename Key, size_t Counters = 256, uint8_t Probes = 3>
+class bloomlist : public observedlist<List, bloomobserver<Key, Counters, Probes>>
+{
+public:
+    typedef typename Key::key_type key_type; ///< type looked up by contains()
+
+    using observedlist<List, bloomobserver<Key, Counters, Probes>>::operator=;
+
+    /// @brief checks the filter only: O(Probes), no list walk
+    /// @param key key to look for
+    /// @return false if no payload has this key; true if one may have
+    bool mayContain(const key_type &key) const
+    {
+        return this->observer.filter.mayContain(Key::hash(key));
+    }
+
+    /// @brief finds the first payload with a key, walking the list only if the filter lets the key through
+    /// @param key key to look for
+    /// @return pointer to the payload, or null if there is none
+    auto find(const key_type &key) -> decltype(&*List::begin())
+    {
+        if (mayContain(key))
+        {
+            for (auto it = List::begin(); it != List::end(); ++it)
+            {
+                if (Key::key(*it) == key)
+                {
+                    return &*it;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief checks whether a payload has a key, see find()
+    /// @param key key to look for
+    /// @return true if a payload has the key
+    bool contains(const key_type &key)
+    {
+        return find(key) != nullptr;
+    }
+};
+
+#endif // BLOOM_LIST_H
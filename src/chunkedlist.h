@@ -0,0 +1,280 @@
+#ifndef CHUNKED_LIST_H
+#define CHUNKED_LIST_H
+
+#include <Arduino.h>
+#include "listsimd.h"
+
+/// @brief node of a chunkedlist: a run of up to ChunkSize payloads
+template <typename T, uint16_t ChunkSize>
+struct chunkedlistnode
+{
+    chunkedlistnode() : first(0U), last(0U), n(nullptr) {}
+    T v[ChunkSize];     ///< payloads; the live ones are v[first] to v[last - 1]
+    uint16_t first;     ///< index of the first live payload
+    uint16_t last;      ///< index past the last live payload
+    chunkedlistnode *n; ///< next chunk or null
+};
+
+/// @brief singly linked list of arithmetic payloads stored ChunkSize to a node
+/// @details Meant for sample buffers (int16_t / int32_t / float readings):
+/// payloads are appended at the tail and dropped from the head, and each node
+/// holds a contiguous run of them. find, countIf, min, max and sum hand each
+/// run to the listsimd kernels, which use SSE2, AVX2 or AArch64 NEON when the
+/// build enables them and a scalar loop otherwise, so a search costs one
+/// pointer hop per chunk instead of per payload.
+///
+/// Comparisons on float payloads holding NaN give unspecified results.
+/// @tparam T arithmetic payload type
+/// @tparam ChunkSize payloads per node
+template <typename T, uint16_t ChunkSize = 32>
+class chunkedlist
+{
+public:
+    static_assert(ChunkSize > 0, "a chunk holds at least one payload");
+
+    /// @brief list node holding one run of payloads
+    typedef chunkedlistnode<T, ChunkSize> chunknode;
+
+    /// @brief accumulator type returned by sum()
+    typedef typename simdsum<T>::type sum_type;
+
+    /// @brief forward iterator over the payloads, head to tail
+    class iterator
+    {
+    public:
+        iterator(chunknode *node, uint16_t index) : current(node), at(index) {}
+        T &operator*() const { return current->v[at]; }
+        T *operator->() const { return &current->v[at]; }
+        iterator &operator++()
+        {
+            if (++at == current->last)
+            {
+                current = current->n;
+                at = current != nullptr ? current->first : 0U;
+            }
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return current == other.current && at == other.at; }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    private:
+        chunknode *current; ///< chunk the iterator is in
+        uint16_t at;        ///< index within the chunk
+    };
+
+    chunkedlist() : head(nullptr), tail(nullptr), list_nodes(0U), chunk_count(0U) {}
+    chunkedlist(const chunkedlist &) = delete;
+    chunkedlist &operator=(const chunkedlist &) = delete;
+
+    ~chunkedlist()
+    {
+        clear();
+    }
+
+    /// @brief appends a payload, allocating a chunk when the tail is full
+    /// @param value payload to append
+    /// @return false on allocation failure
+    bool insertAtEnd(T value)
+    {
+        if (tail == nullptr || tail->last == ChunkSize)
+        {
+            chunknode *node = new chunknode();
+            if (node == nullptr)
+            {
+                return false;
+            }
+            if (tail != nullptr)
+            {
+                tail->n = node;
+            }
+            else
+            {
+                head = node;
+            }
+            tail = node;
+            chunk_count++;
+        }
+        tail->v[tail->last++] = value;
+        list_nodes++;
+        return true;
+    }
+
+    /// @brief drops the first payload, freeing its chunk when it empties
+    /// @return false if the list is empty
+    bool removeAtBeginning()
+    {
+        if (head == nullptr)
+        {
+            return false;
+        }
+        if (++head->first == head->last)
+        {
+            chunknode *next = head->n;
+            delete head;
+            head = next;
+            if (head == nullptr)
+            {
+                tail = nullptr;
+            }
+            chunk_count--;
+        }
+        list_nodes--;
+        return true;
+    }
+
+    /// @brief frees every chunk
+    void clear()
+    {
+        while (head != nullptr)
+        {
+            chunknode *next = head->n;
+            delete head;
+            head = next;
+        }
+        tail = nullptr;
+        list_nodes = 0U;
+        chunk_count = 0U;
+    }
+
+    /// @brief gets the payload at position, one hop per chunk
+    /// @param position 1-... position in the list
+    /// @return pointer to storage at position, or null if out of range
+    T *getStoragePtr(size_t position) const
+    {
+        if (position < 1 || position > list_nodes)
+        {
+            return nullptr; // position out of range
+        }
+        size_t index = position - 1U;
+        chunknode *node = head;
+        while (index >= (size_t)(node->last - node->first))
+        {
+            index -= node->last - node->first;
+            node = node->n;
+        }
+        return &node->v[node->first + index];
+    }
+
+    /// @brief finds the first payload equal to value
+    /// @return pointer to the payload, or null if there is none
+    T *find(T value) const
+    {
+        for (chunknode *node = head; node != nullptr; node = node->n)
+        {
+            size_t count = node->last - node->first;
+            size_t index = listsimd<T>::find(&node->v[node->first], count, value);
+            if (index < count)
+            {
+                return &node->v[node->first + index];
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief counts the payloads that compare true against threshold
+    /// @param op comparison, e.g. THRESHOLD_GREATER counts payloads above threshold
+    /// @param threshold value to compare with
+    /// @return number of matching payloads
+    size_t countIf(thresholdop op, T threshold) const
+    {
+        size_t matched = 0U;
+        for (chunknode *node = head; node != nullptr; node = node->n)
+        {
+            matched += listsimd<T>::countIf(&node->v[node->first], node->last - node->first, op, threshold);
+        }
+        return matched;
+    }
+
+    /// @brief counts the payloads pred accepts, one scalar call per payload
+    /// @param pred callable taking T and returning bool
+    /// @return number of matching payloads
+    template <typename Predicate>
+    size_t countIf(Predicate pred) const
+    {
+        size_t matched = 0U;
+        for (chunknode *node = head; node != nullptr; node = node->n)
+        {
+            for (uint16_t i = node->first; i < node->last; ++i)
+            {
+                matched += pred(node->v[i]) ? 1U : 0U;
+            }
+        }
+        return matched;
+    }
+
+    /// @brief gets the smallest payload
+    /// @param result set to the smallest payload
+    /// @return false if the list is empty
+    bool min(T &result) const
+    {
+        if (head == nullptr)
+        {
+            return false;
+        }
+        result = listsimd<T>::min(&head->v[head->first], head->last - head->first);
+        for (chunknode *node = head->n; node != nullptr; node = node->n)
+        {
+            T best = listsimd<T>::min(&node->v[node->first], node->last - node->first);
+            result = best < result ? best : result;
+        }
+        return true;
+    }
+
+    /// @brief gets the largest payload
+    /// @param result set to the largest payload
+    /// @return false if the list is empty
+    bool max(T &result) const
+    {
+        if (head == nullptr)
+        {
+            return false;
+        }
+        result = listsimd<T>::max(&head->v[head->first], head->last - head->first);
+        for (chunknode *node = head->n; node != nullptr; node = node->n)
+        {
+            T best = listsimd<T>::max(&node->v[node->first], node->last - node->first);
+            result = result < best ? best : result;
+        }
+        return true;
+    }
+
+    /// @brief adds up the payloads in sum_type (int64_t, or double for floating point)
+    /// @return total, 0 if empty
+    sum_type sum() const
+    {
+        sum_type total = 0;
+        for (chunknode *node = head; node != nullptr; node = node->n)
+        {
+            total += listsimd<T>::sum(&node->v[node->first], node->last - node->first);
+        }
+        return total;
+    }
+
+    /// @brief gets the number of payloads
+    /// @return payload count
+    size_t size() const
+    {
+        return list_nodes;
+    }
+
+    /// @brief gets the number of chunks allocated
+    /// @return chunk count
+    size_t chunks() const
+    {
+        return chunk_count;
+    }
+
+    /// @brief iterator at the head, for range-based for loops
+    iterator begin() const { return iterator(head, head != nullptr ? head->first : 0U); }
+
+    /// @brief iterator past the tail
+    iterator end() const { return iterator(nullptr, 0U); }
+
+private:
+    chunknode *head;    ///< oldest chunk
+    chunknode *tail;    ///< chunk being filled
+    size_t list_nodes;  ///< number of payloads
+    size_t chunk_count; ///< number of chunks
+};
+
+#endif // CHUNKED_LIST_H
@@ -2,28 +2,125 @@
 #define CIRCULAR_DOUBLY_LINKED_LIST_H
 
 #include <Arduino.h>
+#include "listtraits.h"
+#include "nodepool.h"
+
+/// @brief list node with pointers to next, previous, and storage
+template <typename NodeStorageType>
+struct circlylistnode
+{
+    /// @brief list node structure, contains pointers to next, previous, and storage
+    /// @param storage_pointer pointer of type NodeStorageType
+    circlylistnode(NodeStorageType *storage_pointer);
+    NodeStorageType *sp; ///< pointer to storage
+    circlylistnode *n;   ///< pointer to next list member (wraps to head)
+    circlylistnode *p;   ///< pointer to previous list member (wraps to tail)
+};
 
 /// @brief inheritable circular doubly linked-list framework
-template <typename NodeStorageType, typename... StorageArgs>
-class circulardoublylist
+/// @tparam Traits list configuration, see listtraits
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+class basic_circulardoublylist : private nodepool<circlylistnode<NodeStorageType>, NodeStorageType, Traits>
 {
 public:
+    /// @brief list node with pointers to next, previous, and storage
+    typedef circlylistnode<NodeStorageType> circlynode;
+
+    /// @brief node count and position type, see listtraits::size_type
+    typedef typename Traits::size_type size_type;
+
+private:
+    /// @brief forward walk prefetcher configured by Traits::prefetch_distance
+    typedef prefetchcursor<circlynode, NodeStorageType, &circlynode::n, Traits::prefetch_distance> prefetcher;
+
+    /// @brief backward walk prefetcher configured by Traits::prefetch_distance
+    typedef prefetchcursor<circlynode, NodeStorageType, &circlynode::p, Traits::prefetch_distance> backprefetcher;
+
+public:
+    /// @brief forward iterator over the stored payloads, head to tail (one lap)
+    class iterator
+    {
+    public:
+        /// @param node first node to visit
+        /// @param count number of nodes left to visit, 0 for end()
+        iterator(circlynode *node, size_type count) : current(node), remaining(count), ahead(node, count > 0 ? count - 1 : 0) {}
+        NodeStorageType &operator*() const { return *current->sp; }
+        NodeStorageType *operator->() const { return current->sp; }
+        /// @brief node the iterator is at
+        circlynode *node() const { return current; }
+        iterator &operator++()
+        {
+            ahead.advance();
+            current = current->n;
+            --remaining;
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return remaining == other.remaining; }
+        bool operator!=(const iterator &other) const { return remaining != other.remaining; }
+
+    private:
+        circlynode *current; ///< node the iterator is at
+        size_type remaining; ///< nodes left to visit including current
+        prefetcher ahead;    ///< prefetches the nodes about to be visited
+    };
+
+    /// @brief backward iterator over the stored payloads, tail to head (one lap)
+    class reverse_iterator
+    {
+    public:
+        /// @param node first node to visit
+        /// @param count number of nodes left to visit, 0 for rend()
+        reverse_iterator(circlynode *node, size_type count) : current(node), remaining(count), ahead(node, count > 0 ? count - 1 : 0) {}
+        NodeStorageType &operator*() const { return *current->sp; }
+        NodeStorageType *operator->() const { return current->sp; }
+        /// @brief node the iterator is at
+        circlynode *node() const { return current; }
+        reverse_iterator &operator++()
+        {
+            ahead.advance();
+            current = current->p;
+            --remaining;
+            return *this;
+        }
+        bool operator==(const reverse_iterator &other) const { return remaining == other.remaining; }
+        bool operator!=(const reverse_iterator &other) const { return remaining != other.remaining; }
+
+    private:
+        circlynode *current;   ///< node the iterator is at
+        size_type remaining;   ///< nodes left to visit including current
+        backprefetcher ahead;  ///< prefetches the nodes about to be visited
+    };
+
     /// @brief Constructor for the linked-list
-    circulardoublylist();
+    basic_circulardoublylist();
+
+    /// @brief Deep copy; the clone is built in a single pass
+    /// @param other list to copy
+    basic_circulardoublylist(const basic_circulardoublylist &other);
+
+    /// @brief Move constructor; steals other's nodes and leaves it empty
+    /// @details O(1) unless Traits::inline_nodes > 0, in which case nodes in
+    /// other's inline slots are moved into this list's inline slots. With
+    /// Traits::slab_slots > 0 the two lists also exchange their slabs
+    /// @param other list to move from
+    basic_circulardoublylist(basic_circulardoublylist &&other) noexcept;
 
     /// @brief Destructor for the linked-list
-    ~circulardoublylist();
+    ~basic_circulardoublylist();
 
-    /// @brief list node with pointers to next, previous, and storage
-    struct circlynode
-    {
-        /// @brief list node structure, contains pointers to next, previous, and storage
-        /// @param storage_pointer pointer of type NodeStorageType
-        circlynode(NodeStorageType *storage_pointer);
-        NodeStorageType *sp; ///< pointer to storage
-        circlynode *n;       ///< pointer to next list member (wraps to head)
-        circlynode *p;       ///< pointer to previous list member (wraps to tail)
-    };
+    /// @brief replaces the contents with a deep copy of other
+    /// @param other list to copy
+    /// @return this list
+    basic_circulardoublylist &operator=(const basic_circulardoublylist &other);
+
+    /// @brief replaces the contents with other's nodes and leaves other empty
+    /// @param other list to move from
+    /// @return this list
+    basic_circulardoublylist &operator=(basic_circulardoublylist &&other) noexcept;
+
+    /// @brief exchanges the contents of two lists
+    /// @param other list to swap with
+    void swap(basic_circulardoublylist &other) noexcept;
 
     /// @brief inserts a node at the beginning of the list
     /// @param args Arguments to construct the storage
@@ -35,16 +132,79 @@ public:
     /// @return node that was inserted
     circlynode *insertAtEnd(StorageArgs... args);
 
+    /// @brief inserts a copy of an existing payload at the end of the list
+    /// @param value payload to copy
+    /// @return node that was inserted
+    circlynode *insertCopyAtEnd(const NodeStorageType &value);
+
+    /// @brief inserts a node at the end, overwriting the head once the list
+    /// holds bound nodes
+    /// @details Below bound this is insertAtEnd(). At bound the head payload is
+    /// destroyed, the new payload is constructed in its slot and head and tail
+    /// advance one step around the circle, so a full sliding window never
+    /// allocates or frees. A list already above bound keeps its size.
+    /// @param bound node count to keep, at least 1
+    /// @param args Arguments to construct the storage
+    /// @return node that was inserted, or null if bound is below 1 or an allocation failed
+    circlynode *insertAtEndBounded(size_type bound, StorageArgs... args);
+
     /// @brief inserts a node at position
     /// @param position 1-... position in the list to insert
     /// @param args Arguments to construct the storage
     /// @return null on error
-    circlynode *insertAtPosition(int position, StorageArgs... args);
+    circlynode *insertAtPosition(size_type position, StorageArgs... args);
 
     /// @brief deletes the node at position
     /// @param position 1-... position of node to delete
     /// @return true on success, false if position is out of range
-    bool deleteFromPosition(int position);
+    bool deleteFromPosition(size_type position);
+
+    /// @brief deletes a node in O(1), without a positional walk
+    /// @param node node of this list, e.g. as returned by an insert
+    /// @return false if node is null
+    bool deleteNode(circlynode *node);
+
+    /// @brief moves one node of another list to the end of this list in O(1),
+    /// without allocating or touching the payload
+    /// @param node node of from
+    /// @param from list that holds node; may be this list
+    /// @return false if node is null, lives in from's inline slots, comes from
+    /// another list allocating from slabs, or this list is full
+    bool spliceAtEnd(circlynode *node, basic_circulardoublylist &from);
+
+    /// @brief moves every node of another list to the end of this list in O(1)
+    /// @param from list to empty into this one
+    /// @return false if the lists use inline slots or slabs, or this list cannot count the nodes
+    bool spliceAllAtEnd(basic_circulardoublylist &from);
+
+    /// @brief deletes the nodes from position first to position last, inclusive
+    /// @param first 1-... position of the first node to delete
+    /// @param last 1-... position of the last node to delete
+    /// @return true on success, false if the range is empty or out of range
+    bool deleteRange(size_type first, size_type last);
+
+    /// @brief deletes every node whose payload matches, in one pass
+    /// @param pred callable taking NodeStorageType & and returning true to delete
+    /// @return number of nodes deleted
+    template <typename Predicate>
+    size_type removeIf(Predicate pred);
+
+    /// @brief reverses the order of the nodes by swapping every node's n and p
+    void reverse();
+
+    /// @brief stable partition: moves the nodes whose payload matches in front
+    /// of the rest, keeping the relative order within both groups
+    /// @param pred callable taking NodeStorageType & and returning true for the front group
+    /// @return first node of the back group, or null if every node matches
+    template <typename Predicate>
+    circlynode *partition(Predicate pred);
+
+    /// @brief deletes each node whose payload equals the payload before it;
+    /// the tail is not compared with the head
+    /// @param eq callable taking two NodeStorageType & and returning true if equal
+    /// @return number of nodes deleted
+    template <typename Equal>
+    size_type unique(Equal eq);
 
     /// @brief clears the list and deallocates memory
     void clear();
@@ -52,47 +212,220 @@ public:
     /// @brief gets the storage pointer at position
     /// @param position 1-... position in the list
     /// @return pointer to storage at position, or null if out of range
-    NodeStorageType *getStoragePtr(int position);
+    NodeStorageType *getStoragePtr(size_type position);
+
+    /// @brief gets the number of list members
+    /// @return node count
+    size_type size() const;
+
+    /// @brief copies payloads, head first, into an array
+    /// @details one linear walk; trivially copyable payloads are copied with memcpy
+    /// @param out array of at least count constructed payloads
+    /// @param count maximum number of payloads to copy
+    /// @return number of payloads copied, min(count, size())
+    size_type copyTo(NodeStorageType *out, size_type count) const;
+
+    /// @brief copies payloads, head first, into a fixed-size array
+    /// @param out array to fill
+    /// @return number of payloads copied, min(N, size())
+    template <size_t N>
+    size_type toArray(NodeStorageType (&out)[N]) const
+    {
+        return copyTo(out, N < (size_t)sizelimit<size_type>::max ? (size_type)N : sizelimit<size_type>::max);
+    }
+
+    /// @brief appends copies of an array of payloads
+    /// @param values payloads to append, in order
+    /// @param count number of payloads
+    /// @return number of payloads appended; less than count on allocation failure
+    size_type fromArray(const NodeStorageType *values, size_type count);
+
+    /// @brief preallocates node slots so inserts up to capacity nodes never
+    /// call the allocator
+    /// @details slots freed by deletes are kept while the list is below the
+    /// reserved capacity. Needs Traits::reservable or slabs (a compile error
+    /// otherwise), so other lists carry no spare-slot state.
+    /// @param capacity node count to hold without allocating
+    /// @return false if an allocation failed; slots allocated so far are kept
+    bool reserve(size_type capacity);
+
+    /// @brief gets the number of nodes the list holds before allocating again
+    /// @return node count plus free preallocated and inline slots
+    size_type capacity() const;
+
+    /// @brief frees the preallocated slots not holding a node and drops the reservation
+    void shrink_to_fit();
+
+    /// @brief reports the bytes the list holds: object, node links, payloads,
+    /// unused slots and estimated allocator overhead
+    /// @return byte counts, see listmemory
+    listmemory memoryUsage() const;
+
+    /// @brief moves every heap node into one new slab in list order, so a walk
+    /// reads memory front to back; needs Traits::slab_slots > 0
+    /// @details Invalidates every node and payload pointer, reference and
+    /// iterator taken before the call; getLastAccessedNode() follows its node.
+    /// Nodes in inline slots stay put. Spare slots and the reservation are
+    /// dropped as by shrink_to_fit(). Needs room for a second copy of the heap
+    /// nodes while it runs.
+    /// @return false if the new slab could not be allocated; the list is unchanged
+    bool compact();
 
     /// @brief gets the last accessed or inserted node
     /// @return pointer to the last accessed node, or null if none
     circlynode *getLastAccessedNode();
 
+    /// @brief iterator at the head, for range-based for loops
+    iterator begin();
+
+    /// @brief iterator one lap past the head
+    iterator end();
+
+    /// @brief backward iterator at the tail
+    reverse_iterator rbegin();
+
+    /// @brief backward iterator one lap past the tail
+    reverse_iterator rend();
+
     /// @brief gets the storage pointer of the last accessed or inserted node
     /// @return pointer to storage of the last accessed node, or null if none
     NodeStorageType *getLastAccessedNodeStoragePtr();
 
 private:
-    /// @brief gets the node at position, updating node_ptr cache
+    /// @brief gets the node at position
     /// @param position 1-... position in the list
     /// @return pointer to node at position, or null if out of range
-    circlynode *getNode(int position);
+    circlynode *getNode(size_type position);
+
+    /// @brief links a node after the tail
+    /// @param new_node node to link
+    /// @return the linked node
+    circlynode *link_at_end(circlynode *new_node);
+
+    /// @brief creates a new node
+    /// @param args Arguments to construct the storage
+    /// @return pointer to the created node, or null on allocation failure
+    circlynode *create_node(StorageArgs... args);
+
+    /// @brief creates a new node holding a copy of value
+    /// @param value payload to copy
+    /// @return pointer to the created node, or null on allocation failure
+    circlynode *create_node_copy(const NodeStorageType &value);
+
+    /// @brief unlinks a node, fixing head, tail, lastnode and the count, without freeing it
+    /// @param node member of this list
+    void unlink_node(circlynode *node);
+
+    /// @brief unlinks a node and deallocates it
+    /// @param node member of this list
+    void erase_node(circlynode *node);
+
+    /// @brief destroys the payload and releases the node, once it is unlinked and uncounted
+    /// @param dealloc_node pointer to the node to deallocate
+    void deallocate_node(circlynode *dealloc_node);
+
+    /// @brief appends copies of other's payloads
+    /// @param other list to copy from
+    void copy_nodes(const basic_circulardoublylist &other);
+
+    /// @brief takes over other's nodes, relocating any that sit in other's inline slots
+    /// @param other list to move from, left empty
+    void take_nodes(basic_circulardoublylist &other);
     circlynode *head;         ///< list head
     circlynode *tail;         ///< list tail
-    circlynode *node_ptr;     ///< traversal cache pointer
     circlynode *lastnode;     ///< last accessed or inserted node
-    NodeStorageType *storage_ptr; ///< temporary storage pointer used by getStoragePtr
-    int list_nodes;           ///< number of list members
+    size_type list_nodes;     ///< number of list members
 };
 
+/// @brief circular doubly linked-list with the default listtraits
 template <typename NodeStorageType, typename... StorageArgs>
-circulardoublylist<NodeStorageType, StorageArgs...>::circulardoublylist() : head(nullptr), tail(nullptr), node_ptr(nullptr), lastnode(nullptr), storage_ptr(nullptr), list_nodes(0) {}
+using circulardoublylist = basic_circulardoublylist<listtraits, NodeStorageType, StorageArgs...>;
 
-template <typename NodeStorageType, typename... StorageArgs>
-circulardoublylist<NodeStorageType, StorageArgs...>::~circulardoublylist()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::basic_circulardoublylist() : head(nullptr), tail(nullptr), lastnode(nullptr), list_nodes(0) {}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::basic_circulardoublylist(const basic_circulardoublylist &other) : head(nullptr), tail(nullptr), lastnode(nullptr), list_nodes(0)
+{
+    copy_nodes(other);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::basic_circulardoublylist(basic_circulardoublylist &&other) noexcept : head(nullptr), tail(nullptr), lastnode(nullptr), list_nodes(0)
+{
+    take_nodes(other);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::~basic_circulardoublylist()
 {
     clear();
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-circulardoublylist<NodeStorageType, StorageArgs...>::circlynode::circlynode(NodeStorageType *storage_pointer) : sp(storage_pointer), n(nullptr), p(nullptr) {}
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...> &
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::operator=(const basic_circulardoublylist &other)
+{
+    if (this != &other)
+    {
+        clear();
+        copy_nodes(other);
+    }
+    return *this;
+}
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename circulardoublylist<NodeStorageType, StorageArgs...>::circlynode *
-circulardoublylist<NodeStorageType, StorageArgs...>::insertAtBeginning(StorageArgs... args)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...> &
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::operator=(basic_circulardoublylist &&other) noexcept
 {
-    NodeStorageType *storage = new NodeStorageType{args...};
-    circlynode *new_node = new circlynode(storage);
+    if (this != &other)
+    {
+        clear();
+        take_nodes(other);
+    }
+    return *this;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::swap(basic_circulardoublylist &other) noexcept
+{
+    if (Traits::inline_nodes > 0)
+    {
+        basic_circulardoublylist temp(static_cast<basic_circulardoublylist &&>(other));
+        other = static_cast<basic_circulardoublylist &&>(*this);
+        *this = static_cast<basic_circulardoublylist &&>(temp);
+        return;
+    }
+    circlynode *node = head;
+    head = other.head;
+    other.head = node;
+    node = tail;
+    tail = other.tail;
+    other.tail = node;
+    node = lastnode;
+    lastnode = other.lastnode;
+    other.lastnode = node;
+    size_type count = list_nodes;
+    list_nodes = other.list_nodes;
+    other.list_nodes = count;
+    if (Traits::slab_slots > 0)
+    {
+        this->swap_slabs(other);
+    }
+}
+
+template <typename NodeStorageType>
+circlylistnode<NodeStorageType>::circlylistnode(NodeStorageType *storage_pointer) : sp(storage_pointer), n(nullptr), p(nullptr) {}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::insertAtBeginning(StorageArgs... args)
+{
+    circlynode *new_node = create_node(args...);
+    if (new_node == nullptr)
+    {
+        return nullptr;
+    }
     if (head == nullptr)
     {
         head = tail = new_node;
@@ -111,12 +444,49 @@ circulardoublylist<NodeStorageType, StorageArgs...>::insertAtBeginning(StorageAr
     return new_node;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename circulardoublylist<NodeStorageType, StorageArgs...>::circlynode *
-circulardoublylist<NodeStorageType, StorageArgs...>::insertAtEnd(StorageArgs... args)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::insertAtEnd(StorageArgs... args)
+{
+    return link_at_end(create_node(args...));
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::insertCopyAtEnd(const NodeStorageType &value)
 {
-    NodeStorageType *storage = new NodeStorageType{args...};
-    circlynode *new_node = new circlynode(storage);
+    return link_at_end(create_node_copy(value));
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::insertAtEndBounded(size_type bound, StorageArgs... args)
+{
+    if (bound < 1)
+    {
+        return nullptr;
+    }
+    if (list_nodes < bound)
+    {
+        return insertAtEnd(args...);
+    }
+    circlynode *recycled = head; // tail->n already points at it: rotate instead of relinking
+    recycled->sp->~NodeStorageType();
+    recycled->sp = new (recycled->sp) NodeStorageType{args...};
+    head = recycled->n;
+    tail = recycled;
+    lastnode = recycled;
+    return recycled;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::link_at_end(circlynode *new_node)
+{
+    if (new_node == nullptr)
+    {
+        return nullptr;
+    }
     if (tail == nullptr)
     {
         head = tail = new_node;
@@ -135,11 +505,11 @@ circulardoublylist<NodeStorageType, StorageArgs...>::insertAtEnd(StorageArgs...
     return new_node;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename circulardoublylist<NodeStorageType, StorageArgs...>::circlynode *
-circulardoublylist<NodeStorageType, StorageArgs...>::insertAtPosition(int position, StorageArgs... args)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::insertAtPosition(size_type position, StorageArgs... args)
 {
-    if (position < 1 || position > list_nodes + 1)
+    if (position < 1 || position - 1 > list_nodes)
     {
         return nullptr;
     }
@@ -147,13 +517,16 @@ circulardoublylist<NodeStorageType, StorageArgs...>::insertAtPosition(int positi
     {
         return insertAtBeginning(args...);
     }
-    if (position == list_nodes + 1)
+    if (position - 1 == list_nodes)
     {
         return insertAtEnd(args...);
     }
 
-    NodeStorageType *storage = new NodeStorageType{args...};
-    circlynode *new_node = new circlynode(storage);
+    circlynode *new_node = create_node(args...);
+    if (new_node == nullptr)
+    {
+        return nullptr;
+    }
     circlynode *current = getNode(position);
 
     new_node->n = current;
@@ -166,67 +539,227 @@ circulardoublylist<NodeStorageType, StorageArgs...>::insertAtPosition(int positi
     return new_node;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-bool circulardoublylist<NodeStorageType, StorageArgs...>::deleteFromPosition(int position)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::deleteFromPosition(size_type position)
 {
     if (position < 1 || position > list_nodes)
     {
         return false;
     }
 
-    circlynode *node_to_delete = getNode(position);
+    erase_node(getNode(position));
+    return true;
+}
 
-    if (list_nodes == 1)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::deleteNode(circlynode *node)
+{
+    if (node == nullptr)
     {
-        head = tail = nullptr;
+        return false;
+    }
+    erase_node(node);
+    return true;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::spliceAtEnd(circlynode *node, basic_circulardoublylist &from)
+{
+    if (node == nullptr || from.is_inline(node) || (Traits::slab_slots > 0 && &from != this))
+    {
+        return false; // inline and slab slots cannot leave their list
+    }
+    if (&from != this && list_nodes == sizelimit<size_type>::max)
+    {
+        return false; // size_type cannot count another node
+    }
+    from.unlink_node(node);
+    link_at_end(node);
+    return true;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::spliceAllAtEnd(basic_circulardoublylist &from)
+{
+    if (Traits::inline_nodes > 0 || Traits::slab_slots > 0 || &from == this || sizelimit<size_type>::max - list_nodes < from.list_nodes)
+    {
+        return false;
+    }
+    if (from.list_nodes == 0)
+    {
+        return true;
+    }
+    if (list_nodes == 0)
+    {
+        head = from.head;
+        tail = from.tail;
     }
     else
     {
-        if (node_to_delete == head)
+        tail->n = from.head;
+        from.head->p = tail;
+        from.tail->n = head;
+        head->p = from.tail;
+        tail = from.tail;
+    }
+    list_nodes += from.list_nodes;
+    from.head = from.tail = from.lastnode = nullptr;
+    from.list_nodes = 0;
+    return true;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::deleteRange(size_type first, size_type last)
+{
+    if (first < 1 || last < first || last > list_nodes)
+    {
+        return false; // range empty or out of range
+    }
+    circlynode *current = getNode(first);
+    for (size_type k = last - first + 1; k > 0; --k) // counts down: last may be size_type's maximum
+    {
+        circlynode *next = current->n;
+        erase_node(current);
+        current = next;
+    }
+    return true;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+template <typename Predicate>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::removeIf(Predicate pred)
+{
+    size_type removed = 0U;
+    size_type count = list_nodes;
+    circlynode *current = head;
+    prefetcher ahead(head, count > 0 ? count - 1 : 0);
+    for (size_type i = 0; i < count; ++i)
+    {
+        ahead.advance();
+        circlynode *next = current->n;
+        if (pred(*current->sp))
         {
-            head = head->n;
+            erase_node(current);
+            ++removed;
+        }
+        current = next;
+    }
+    return removed;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::reverse()
+{
+    circlynode *current = head;
+    for (size_type i = 0; i < list_nodes; ++i)
+    {
+        circlynode *next = current->n;
+        current->n = current->p;
+        current->p = next;
+        current = next;
+    }
+    current = head;
+    head = tail;
+    tail = current;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+template <typename Predicate>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::partition(Predicate pred)
+{
+    if (list_nodes == 0)
+    {
+        return nullptr;
+    }
+    circlynode *front_head = nullptr;
+    circlynode *front_tail = nullptr;
+    circlynode *back_head = nullptr;
+    circlynode *back_tail = nullptr;
+    circlynode *current = head;
+    for (size_type i = 0; i < list_nodes; ++i)
+    {
+        circlynode *next = current->n;
+        bool front = pred(*current->sp);
+        circlynode *&group_head = front ? front_head : back_head;
+        circlynode *&group_tail = front ? front_tail : back_tail;
+        if (group_head == nullptr)
+        {
+            group_head = current;
         }
-        if (node_to_delete == tail)
+        else
         {
-            tail = tail->p;
+            group_tail->n = current;
+            current->p = group_tail;
         }
-        node_to_delete->p->n = node_to_delete->n;
-        node_to_delete->n->p = node_to_delete->p;
+        group_tail = current;
+        current = next;
     }
+    if (front_tail != nullptr && back_head != nullptr)
+    {
+        front_tail->n = back_head;
+        back_head->p = front_tail;
+    }
+    head = front_head != nullptr ? front_head : back_head;
+    tail = back_tail != nullptr ? back_tail : front_tail;
+    tail->n = head;
+    head->p = tail;
+    return back_head;
+}
 
-    delete node_to_delete->sp;
-    delete node_to_delete;
-
-    list_nodes--;
-    return true;
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+template <typename Equal>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::unique(Equal eq)
+{
+    size_type removed = 0U;
+    circlynode *prev = head;
+    while (prev != tail)
+    {
+        if (eq(*prev->sp, *prev->n->sp))
+        {
+            erase_node(prev->n);
+            ++removed;
+        }
+        else
+        {
+            prev = prev->n;
+        }
+    }
+    return removed;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-void circulardoublylist<NodeStorageType, StorageArgs...>::clear()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::clear()
 {
+    if (list_nodes == 0)
+    {
+        return;
+    }
+    prefetcher ahead(head, list_nodes - 1);
     while (list_nodes > 0)
     {
+        ahead.advance();
         deleteFromPosition(1);
     }
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-NodeStorageType *circulardoublylist<NodeStorageType, StorageArgs...>::getStoragePtr(int position)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+NodeStorageType *basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::getStoragePtr(size_type position)
 {
-    storage_ptr = nullptr;
     circlynode *access = getNode(position);
     if (access != nullptr)
     {
-        storage_ptr = access->sp;
         lastnode = access;
-        return storage_ptr;
+        return access->sp;
     }
-    return storage_ptr;
+    return nullptr;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename circulardoublylist<NodeStorageType, StorageArgs...>::circlynode *
-circulardoublylist<NodeStorageType, StorageArgs...>::getNode(int position)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::getNode(size_type position)
 {
     if (list_nodes == 0 || position < 1)
     {
@@ -238,43 +771,323 @@ circulardoublylist<NodeStorageType, StorageArgs...>::getNode(int position)
     }
     if (position == 1)
     {
-        return node_ptr = head;
+        return head;
     }
     if (position == list_nodes)
     {
-        return node_ptr = tail;
+        return tail;
     }
 
+    circlynode *current;
     if ((list_nodes - position) < (list_nodes / 2))
     {
-        node_ptr = tail;
-        for (int i = 0; i < list_nodes - position; ++i)
+        current = tail;
+        backprefetcher ahead(tail, list_nodes - position);
+        for (size_type i = 0; i < list_nodes - position; ++i)
         {
-            node_ptr = node_ptr->p;
+            ahead.advance();
+            current = current->p;
         }
     }
     else
     {
-        node_ptr = head;
-        for (int i = 1; i < position; ++i)
+        current = head;
+        prefetcher ahead(head, position - 1);
+        for (size_type i = 1; i < position; ++i)
         {
-            node_ptr = node_ptr->n;
+            ahead.advance();
+            current = current->n;
         }
     }
-    return node_ptr;
+    return current;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename circulardoublylist<NodeStorageType, StorageArgs...>::circlynode *
-circulardoublylist<NodeStorageType, StorageArgs...>::getLastAccessedNode()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::size() const
+{
+    return list_nodes;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::copyTo(NodeStorageType *out, size_type count) const
+{
+    size_type copied = 0U;
+    circlynode *current = head;
+    size_type walk = count < list_nodes ? count : list_nodes;
+    prefetcher ahead(head, walk > 0 ? walk - 1 : 0);
+    while (copied < count && copied < list_nodes)
+    {
+        ahead.advance();
+        assign_payload(out[copied++], *current->sp);
+        current = current->n;
+    }
+    return copied;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::fromArray(const NodeStorageType *values, size_type count)
+{
+    size_type appended = 0U;
+    while (appended < count && link_at_end(create_node_copy(values[appended])) != nullptr)
+    {
+        ++appended;
+    }
+    return appended;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::reserve(size_type capacity)
+{
+    static_assert(Traits::reservable || Traits::slab_slots > 0, "reserve() needs a list that keeps spare slots, e.g. reservetraits or slabtraits<N>");
+    return this->reserve_slots(list_nodes, capacity);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::capacity() const
+{
+    return list_nodes + this->available_slots();
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::shrink_to_fit()
+{
+    this->shrink_slots();
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+listmemory basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::memoryUsage() const
+{
+    return this->slot_usage(list_nodes, sizeof(*this));
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::compact()
+{
+    static_assert(Traits::slab_slots > 0, "compact() needs a list that allocates from slabs, e.g. slabtraits<N>");
+    size_type heap = this->heap_nodes(list_nodes);
+    if (heap == 0)
+    {
+        this->shrink_slots();
+        return true;
+    }
+    circlynode *first_slot = this->take_slab(heap);
+    if (first_slot == nullptr)
+    {
+        return false;
+    }
+    circlynode *slot = first_slot;
+    circlynode *previous = nullptr;
+    circlynode *current = head;
+    for (size_type i = list_nodes; i > 0; --i)
+    {
+        circlynode *next = current->n;
+        circlynode *node = current;
+        if (!this->is_inline(current))
+        {
+            node = slot;
+            slot = this->next_slot(slot);
+            node->sp = new (node->sp) NodeStorageType(static_cast<NodeStorageType &&>(*current->sp));
+            current->sp->~NodeStorageType();
+            if (current == lastnode)
+            {
+                lastnode = node;
+            }
+        }
+        if (previous != nullptr)
+        {
+            previous->n = node;
+            node->p = previous;
+        }
+        else
+        {
+            head = node;
+        }
+        previous = node;
+        current = next;
+    }
+    tail = previous;
+    if (tail != nullptr)
+    {
+        tail->n = head;
+        head->p = tail;
+    }
+    this->finish_compaction(first_slot); // every other slab is empty now
+    return true;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::getLastAccessedNode()
 {
     return lastnode;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-NodeStorageType *circulardoublylist<NodeStorageType, StorageArgs...>::getLastAccessedNodeStoragePtr()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+NodeStorageType *basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::getLastAccessedNodeStoragePtr()
 {
     return lastnode ? lastnode->sp : nullptr;
 }
 
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::iterator
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::begin()
+{
+    return iterator(head, list_nodes);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::iterator
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::end()
+{
+    return iterator(head, 0);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::reverse_iterator
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::rbegin()
+{
+    return reverse_iterator(tail, list_nodes);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::reverse_iterator
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::rend()
+{
+    return reverse_iterator(tail, 0);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::create_node(StorageArgs... args)
+{
+    if (list_nodes == sizelimit<size_type>::max)
+    {
+        return nullptr; // size_type cannot count another node
+    }
+    circlynode *new_node = this->acquire_slot();
+    if (new_node == nullptr)
+    {
+        return nullptr;
+    }
+    new_node->sp = new (new_node->sp) NodeStorageType{args...};
+    return new_node;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::circlynode *
+basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::create_node_copy(const NodeStorageType &value)
+{
+    if (list_nodes == sizelimit<size_type>::max)
+    {
+        return nullptr; // size_type cannot count another node
+    }
+    circlynode *new_node = this->acquire_slot();
+    if (new_node == nullptr)
+    {
+        return nullptr;
+    }
+    new_node->sp = copy_payload(new_node->sp, value);
+    return new_node;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::unlink_node(circlynode *node)
+{
+    if (list_nodes == 1)
+    {
+        head = tail = nullptr;
+    }
+    else
+    {
+        if (node == head)
+        {
+            head = head->n;
+        }
+        if (node == tail)
+        {
+            tail = tail->p;
+        }
+        node->p->n = node->n;
+        node->n->p = node->p;
+    }
+    if (node == lastnode)
+    {
+        lastnode = nullptr;
+    }
+    list_nodes--;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::erase_node(circlynode *node)
+{
+    unlink_node(node);
+    deallocate_node(node);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::deallocate_node(circlynode *dealloc_node)
+{
+    dealloc_node->sp->~NodeStorageType();
+    this->release_slot(dealloc_node, list_nodes);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::copy_nodes(const basic_circulardoublylist &other)
+{
+    circlynode *source = other.head;
+    for (size_type i = 0; i < other.list_nodes; ++i, source = source->n)
+    {
+        if (link_at_end(create_node_copy(*source->sp)) == nullptr)
+        {
+            return; // allocation failure, keep the partial copy
+        }
+    }
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_circulardoublylist<Traits, NodeStorageType, StorageArgs...>::take_nodes(basic_circulardoublylist &other)
+{
+    if (Traits::inline_nodes == 0)
+    {
+        head = other.head;
+        tail = other.tail;
+        lastnode = other.lastnode;
+        list_nodes = other.list_nodes;
+    }
+    else
+    {
+        // other's inline nodes cannot leave other; move their payloads into
+        // our inline slots, which are all free because this list is empty
+        circlynode *source = other.head;
+        for (size_type i = other.list_nodes; i > 0; --i)
+        {
+            circlynode *next = source->n;
+            circlynode *node = source;
+            if (other.is_inline(source))
+            {
+                node = this->take_inline();
+                node->sp = new (node->sp) NodeStorageType(static_cast<NodeStorageType &&>(*source->sp));
+                source->sp->~NodeStorageType();
+                other.give_inline(source);
+            }
+            link_at_end(node);
+            if (source == other.lastnode)
+            {
+                lastnode = node;
+            }
+            source = next;
+        }
+    }
+    if (Traits::slab_slots > 0)
+    {
+        this->swap_slabs(other); // the nodes stay in other's slabs
+    }
+    other.head = other.tail = other.lastnode = nullptr;
+    other.list_nodes = 0;
+}
+
 #endif // CIRCULAR_DOUBLY_LINKED_LIST_H
\ No newline at end of file
@@ -0,0 +1,321 @@
+#ifndef HANDLE_LIST_H
+#define HANDLE_LIST_H
+
+#include <Arduino.h>
+#include <new>
+
+/// @brief reference to a handlelist element: slot index plus slot generation
+/// @details A default-constructed handle is null and never refers to an
+/// element. Handles stay cheap to copy and compare and carry no pointer, so
+/// one outliving its element is detected rather than dereferenced.
+struct listhandle
+{
+    listhandle() : index(0U), generation(0U) {}
+    listhandle(uint16_t slot, uint16_t slot_generation) : index(slot), generation(slot_generation) {}
+
+    /// @brief checks whether the handle was issued at all; a non-null handle may still be stale
+    bool isNull() const { return generation == 0U; }
+
+    bool operator==(const listhandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const listhandle &other) const { return !(*this == other); }
+
+    uint16_t index;      ///< slot the element was stored in
+    uint16_t generation; ///< slot generation when it was stored, odd; 0 for null
+};
+
+/// @brief smallest unsigned type able to hold slot indices 0 to Capacity
+template <bool Small>
+struct handleindex
+{
+    typedef uint8_t type;
+};
+
+template <>
+struct handleindex<false>
+{
+    typedef uint16_t type;
+};
+
+/// @brief fixed-capacity doubly linked list addressed by generation-checked handles
+/// @details Elements live in Capacity slots inside the object and are linked
+/// by slot index, so the list never touches the heap. Every insert returns a
+/// listhandle; get() and erase() look the slot up directly and compare
+/// generations, so both are O(1) and a handle to an erased element returns
+/// null / false instead of reaching a reused slot.
+///
+/// A slot's generation advances on every insert and erase, and freed slots
+/// are reused oldest first, so a stale handle could only match again after
+/// its slot has been reused 32768 times. Payload pointers from get() are
+/// stable until the element is erased.
+/// @tparam Capacity number of slots, at most 65534
+template <typename NodeStorageType, uint16_t Capacity, typename... StorageArgs>
+class handlelist
+{
+public:
+    static_assert(Capacity > 0 && Capacity < 65535U, "a handlelist holds 1 to 65534 elements");
+
+    /// @brief element handle type
+    typedef listhandle handle;
+
+private:
+    /// @brief slot index type; Capacity marks the end of a chain
+    typedef typename handleindex<(Capacity < 255U)>::type index_type;
+
+    /// @brief payload storage and index links of one element
+    struct slot
+    {
+        alignas(NodeStorageType) unsigned char storage[sizeof(NodeStorageType)]; ///< payload bytes
+        index_type n;        ///< next slot in the list or on the free chain
+        index_type p;        ///< previous slot in the list
+        uint16_t generation; ///< odd while the slot holds an element
+
+        NodeStorageType *payload() { return reinterpret_cast<NodeStorageType *>(storage); }
+    };
+
+    static const index_type none = Capacity; ///< end-of-chain index
+
+public:
+    /// @brief forward iterator over the payloads, head to tail
+    class iterator
+    {
+    public:
+        iterator(handlelist *owner, index_type index) : list(owner), at(index) {}
+        NodeStorageType &operator*() const { return *list->slots[at].payload(); }
+        NodeStorageType *operator->() const { return list->slots[at].payload(); }
+        /// @brief handle of the element the iterator is at
+        listhandle handle() const { return listhandle(at, list->slots[at].generation); }
+        iterator &operator++()
+        {
+            at = list->slots[at].n;
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return at == other.at; }
+        bool operator!=(const iterator &other) const { return at != other.at; }
+
+    private:
+        handlelist *list; ///< list being walked
+        index_type at;    ///< slot the iterator is at
+    };
+
+    handlelist() : head(none), tail(none), free_head(0U), free_tail(Capacity - 1U), list_nodes(0U)
+    {
+        for (uint16_t i = 0; i < Capacity; ++i)
+        {
+            slots[i].n = (index_type)(i + 1U);
+            slots[i].p = none;
+            slots[i].generation = 0U;
+        }
+    }
+
+    handlelist(const handlelist &) = delete;
+    handlelist &operator=(const handlelist &) = delete;
+
+    ~handlelist()
+    {
+        clear();
+    }
+
+    /// @brief inserts an element at the head in O(1)
+    /// @param args Arguments to construct the storage
+    /// @return handle of the element, or a null handle if every slot is in use
+    listhandle insertAtBeginning(StorageArgs... args)
+    {
+        index_type index = take_slot();
+        if (index == none)
+        {
+            return listhandle();
+        }
+        new (slots[index].storage) NodeStorageType{args...};
+        link_between(none, head, index);
+        return listhandle(index, slots[index].generation);
+    }
+
+    /// @brief inserts an element at the tail in O(1)
+    /// @param args Arguments to construct the storage
+    /// @return handle of the element, or a null handle if every slot is in use
+    listhandle insertAtEnd(StorageArgs... args)
+    {
+        index_type index = take_slot();
+        if (index == none)
+        {
+            return listhandle();
+        }
+        new (slots[index].storage) NodeStorageType{args...};
+        link_between(tail, none, index);
+        return listhandle(index, slots[index].generation);
+    }
+
+    /// @brief inserts an element right after another in O(1)
+    /// @param where handle of an element of this list
+    /// @param args Arguments to construct the storage
+    /// @return handle of the element, or a null handle if where is stale or every slot is in use
+    listhandle insertAfter(listhandle where, StorageArgs... args)
+    {
+        if (!contains(where))
+        {
+            return listhandle();
+        }
+        index_type index = take_slot();
+        if (index == none)
+        {
+            return listhandle();
+        }
+        new (slots[index].storage) NodeStorageType{args...};
+        link_between((index_type)where.index, slots[where.index].n, index);
+        return listhandle(index, slots[index].generation);
+    }
+
+    /// @brief looks an element up in O(1)
+    /// @param element handle returned by an insert
+    /// @return pointer to the payload, or null if the element was erased or the handle is null
+    NodeStorageType *get(listhandle element)
+    {
+        return contains(element) ? slots[element.index].payload() : nullptr;
+    }
+
+    /// @brief looks an element up in O(1)
+    /// @param element handle returned by an insert
+    /// @return pointer to the payload, or null if the element was erased or the handle is null
+    const NodeStorageType *get(listhandle element) const
+    {
+        return const_cast<handlelist *>(this)->get(element);
+    }
+
+    /// @brief checks whether a handle still refers to an element of this list
+    /// @param element handle to check
+    /// @return false for null handles and handles of erased elements
+    bool contains(listhandle element) const
+    {
+        return element.index < Capacity && !element.isNull() && slots[element.index].generation == element.generation;
+    }
+
+    /// @brief unlinks and destroys an element in O(1)
+    /// @param element handle returned by an insert
+    /// @return false if the element was already erased or the handle is null
+    bool erase(listhandle element)
+    {
+        if (!contains(element))
+        {
+            return false;
+        }
+        release_slot((index_type)element.index);
+        return true;
+    }
+
+    /// @brief erases the first element
+    /// @return false if the list is empty
+    bool removeAtBeginning()
+    {
+        if (head == none)
+        {
+            return false;
+        }
+        release_slot(head);
+        return true;
+    }
+
+    /// @brief gets the handle of the first element
+    /// @return handle, or a null handle if the list is empty
+    listhandle front() const
+    {
+        return head != none ? listhandle(head, slots[head].generation) : listhandle();
+    }
+
+    /// @brief gets the handle of the last element
+    /// @return handle, or a null handle if the list is empty
+    listhandle back() const
+    {
+        return tail != none ? listhandle(tail, slots[tail].generation) : listhandle();
+    }
+
+    /// @brief erases every element; their handles all become stale
+    void clear()
+    {
+        while (head != none)
+        {
+            release_slot(head);
+        }
+    }
+
+    /// @brief gets the number of elements
+    /// @return element count
+    size_t size() const
+    {
+        return list_nodes;
+    }
+
+    /// @brief gets the number of slots
+    /// @return Capacity
+    size_t capacity() const
+    {
+        return Capacity;
+    }
+
+    /// @brief iterator at the head, for range-based for loops
+    iterator begin() { return iterator(this, head); }
+
+    /// @brief iterator past the tail
+    iterator end() { return iterator(this, none); }
+
+private:
+    /// @brief takes the oldest free slot and marks it live
+    /// @return slot index, or none if every slot is in use
+    index_type take_slot()
+    {
+        index_type index = free_head;
+        if (index == none)
+        {
+            return none;
+        }
+        free_head = slots[index].n;
+        if (free_head == none)
+        {
+            free_tail = none;
+        }
+        slots[index].generation = next_generation(slots[index].generation);
+        return index;
+    }
+
+    /// @brief links a live slot between two neighbours
+    /// @param before slot to precede it, or none for the head
+    /// @param after slot to follow it, or none for the tail
+    /// @param index slot to link
+    void link_between(index_type before, index_type after, index_type index)
+    {
+        slots[index].p = before;
+        slots[index].n = after;
+        (before != none ? slots[before].n : head) = index;
+        (after != none ? slots[after].p : tail) = index;
+        list_nodes++;
+    }
+
+    /// @brief unlinks a live slot, destroys its payload and queues it for reuse
+    /// @param index slot to free
+    void release_slot(index_type index)
+    {
+        slot &freed = slots[index];
+        (freed.p != none ? slots[freed.p].n : head) = freed.n;
+        (freed.n != none ? slots[freed.n].p : tail) = freed.p;
+        freed.payload()->~NodeStorageType();
+        freed.generation = next_generation(freed.generation);
+        freed.n = none;
+        (free_tail != none ? slots[free_tail].n : free_head) = index;
+        free_tail = index;
+        list_nodes--;
+    }
+
+    /// @brief advances a generation, skipping 0 so no live slot matches a null handle
+    static uint16_t next_generation(uint16_t generation)
+    {
+        return generation == 0xFFFFU ? 2U : (uint16_t)(generation + 1U);
+    }
+
+    slot slots[Capacity];  ///< element storage
+    index_type head;       ///< first element, none if empty
+    index_type tail;       ///< last element, none if empty
+    index_type free_head;  ///< oldest free slot, none if full
+    index_type free_tail;  ///< newest free slot, none if full
+    uint16_t list_nodes;   ///< number of elements
+};
+
+#endif // HANDLE_LIST_H
@@ -0,0 +1,519 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <Arduino.h>
+
+/// @brief link a struct embeds to be put on an intrusivesinglylist
+/// @details Copying an object does not copy its links: a copy starts
+/// unlinked, and assigning an object leaves the target's links alone.
+template <typename T>
+struct singlyhook
+{
+    singlyhook() : n(nullptr) {}
+    singlyhook(const singlyhook &) : n(nullptr) {}
+    singlyhook &operator=(const singlyhook &) { return *this; }
+    T *n; ///< next object or null
+};
+
+/// @brief links a struct embeds to be put on an intrusivecircularlist
+/// @details Copying an object does not copy its links, see singlyhook.
+template <typename T>
+struct circlyhook
+{
+    circlyhook() : n(nullptr), p(nullptr) {}
+    circlyhook(const circlyhook &) : n(nullptr), p(nullptr) {}
+    circlyhook &operator=(const circlyhook &) { return *this; }
+
+    /// @brief checks whether the object is on a list through this hook
+    bool isLinked() const { return n != nullptr; }
+
+    T *n; ///< next object, null while unlinked
+    T *p; ///< previous object, null while unlinked
+};
+
+/// @brief singly linked list of existing objects, linked through a member hook
+/// @details The list never allocates, copies or destroys an object; it only
+/// sets the n pointer of the hook named by Hook. A struct with several hooks
+/// can be on several lists at once, one per hook. Objects must outlive their
+/// membership; the destructor and clear() unlink every object.
+///
+/// Linking at either end and removing the head are O(1); unlink() walks to
+/// the predecessor. Use intrusivecircularlist for O(1) unlink anywhere.
+/// @tparam T object type
+/// @tparam Hook the singlyhook member of T this list links through
+template <typename T, singlyhook<T> T::*Hook>
+class intrusivesinglylist
+{
+public:
+    /// @brief forward iterator over the objects, head to tail
+    class iterator
+    {
+    public:
+        explicit iterator(T *object) : current(object) {}
+        T &operator*() const { return *current; }
+        T *operator->() const { return current; }
+        iterator &operator++()
+        {
+            current = (current->*Hook).n;
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return current == other.current; }
+        bool operator!=(const iterator &other) const { return current != other.current; }
+
+    private:
+        T *current; ///< object the iterator is at
+    };
+
+    intrusivesinglylist() : head(nullptr), tail(nullptr), list_nodes(0U) {}
+    intrusivesinglylist(const intrusivesinglylist &) = delete;
+    intrusivesinglylist &operator=(const intrusivesinglylist &) = delete;
+
+    ~intrusivesinglylist()
+    {
+        clear();
+    }
+
+    /// @brief links an object at the head in O(1)
+    /// @param object object not on a list through Hook
+    void linkAtBeginning(T &object)
+    {
+        (object.*Hook).n = head;
+        head = &object;
+        if (tail == nullptr)
+        {
+            tail = &object;
+        }
+        list_nodes++;
+    }
+
+    /// @brief links an object at the tail in O(1)
+    /// @param object object not on a list through Hook
+    void linkAtEnd(T &object)
+    {
+        (object.*Hook).n = nullptr;
+        if (tail != nullptr)
+        {
+            (tail->*Hook).n = &object;
+        }
+        else
+        {
+            head = &object;
+        }
+        tail = &object;
+        list_nodes++;
+    }
+
+    /// @brief links an object right after another in O(1)
+    /// @param position object of this list
+    /// @param object object not on a list through Hook
+    void linkAfter(T &position, T &object)
+    {
+        (object.*Hook).n = (position.*Hook).n;
+        (position.*Hook).n = &object;
+        if (tail == &position)
+        {
+            tail = &object;
+        }
+        list_nodes++;
+    }
+
+    /// @brief unlinks the head in O(1)
+    /// @return the object unlinked, or null if the list is empty
+    T *removeAtBeginning()
+    {
+        T *object = head;
+        if (object == nullptr)
+        {
+            return nullptr;
+        }
+        head = (object->*Hook).n;
+        if (head == nullptr)
+        {
+            tail = nullptr;
+        }
+        (object->*Hook).n = nullptr;
+        list_nodes--;
+        return object;
+    }
+
+    /// @brief unlinks an object, walking from the head to its predecessor
+    /// @param object object to unlink
+    /// @return false if object is not on this list
+    bool unlink(T &object)
+    {
+        if (head == &object)
+        {
+            return removeAtBeginning() != nullptr;
+        }
+        for (T *before = head; before != nullptr; before = (before->*Hook).n)
+        {
+            if ((before->*Hook).n == &object)
+            {
+                unlink_after(*before);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// @brief unlinks every object pred accepts, in one pass
+    /// @param pred callable taking T & and returning true to unlink
+    /// @return number of objects unlinked
+    template <typename Predicate>
+    size_t removeIf(Predicate pred)
+    {
+        size_t removed = 0U;
+        while (head != nullptr && pred(*head))
+        {
+            removeAtBeginning();
+            ++removed;
+        }
+        T *before = head;
+        while (before != nullptr && (before->*Hook).n != nullptr)
+        {
+            if (pred(*(before->*Hook).n))
+            {
+                unlink_after(*before);
+                ++removed;
+            }
+            else
+            {
+                before = (before->*Hook).n;
+            }
+        }
+        return removed;
+    }
+
+    /// @brief unlinks every object
+    void clear()
+    {
+        while (removeAtBeginning() != nullptr)
+        {
+        }
+    }
+
+    /// @brief gets the first object
+    /// @return head, or null if empty
+    T *front() const
+    {
+        return head;
+    }
+
+    /// @brief gets the last object
+    /// @return tail, or null if empty
+    T *back() const
+    {
+        return tail;
+    }
+
+    /// @brief gets the object at position, walking from the head
+    /// @param position 1-... position in the list
+    /// @return object at position, or null if out of range
+    T *getStoragePtr(size_t position) const
+    {
+        if (position < 1 || position > list_nodes)
+        {
+            return nullptr; // position out of range
+        }
+        T *current = head;
+        for (size_t i = 1; i < position; ++i)
+        {
+            current = (current->*Hook).n;
+        }
+        return current;
+    }
+
+    /// @brief gets the number of linked objects
+    /// @return object count
+    size_t size() const
+    {
+        return list_nodes;
+    }
+
+    /// @brief iterator at the head, for range-based for loops
+    iterator begin() const { return iterator(head); }
+
+    /// @brief iterator past the tail
+    iterator end() const { return iterator(nullptr); }
+
+private:
+    /// @brief unlinks the object following before
+    void unlink_after(T &before)
+    {
+        T *object = (before.*Hook).n;
+        (before.*Hook).n = (object->*Hook).n;
+        if (tail == object)
+        {
+            tail = &before;
+        }
+        (object->*Hook).n = nullptr;
+        list_nodes--;
+    }
+
+    T *head;           ///< first object
+    T *tail;           ///< last object
+    size_t list_nodes; ///< number of linked objects
+};
+
+/// @brief circular doubly linked list of existing objects, linked through a member hook
+/// @details Like intrusivesinglylist, but every link and unlink is O(1)
+/// through the object itself, and a hook tells whether its object is linked.
+/// @tparam T object type
+/// @tparam Hook the circlyhook member of T this list links through
+template <typename T, circlyhook<T> T::*Hook>
+class intrusivecircularlist
+{
+public:
+    /// @brief forward iterator over the objects, head to tail (one lap)
+    class iterator
+    {
+    public:
+        /// @param object first object to visit
+        /// @param count number of objects left to visit, 0 for end()
+        iterator(T *object, size_t count) : current(object), remaining(count) {}
+        T &operator*() const { return *current; }
+        T *operator->() const { return current; }
+        iterator &operator++()
+        {
+            current = (current->*Hook).n;
+            --remaining;
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return remaining == other.remaining; }
+        bool operator!=(const iterator &other) const { return remaining != other.remaining; }
+
+    private:
+        T *current;       ///< object the iterator is at
+        size_t remaining; ///< objects left to visit including current
+    };
+
+    /// @brief backward iterator over the objects, tail to head (one lap)
+    class reverse_iterator
+    {
+    public:
+        /// @param object first object to visit
+        /// @param count number of objects left to visit, 0 for rend()
+        reverse_iterator(T *object, size_t count) : current(object), remaining(count) {}
+        T &operator*() const { return *current; }
+        T *operator->() const { return current; }
+        reverse_iterator &operator++()
+        {
+            current = (current->*Hook).p;
+            --remaining;
+            return *this;
+        }
+        bool operator==(const reverse_iterator &other) const { return remaining == other.remaining; }
+        bool operator!=(const reverse_iterator &other) const { return remaining != other.remaining; }
+
+    private:
+        T *current;       ///< object the iterator is at
+        size_t remaining; ///< objects left to visit including current
+    };
+
+    intrusivecircularlist() : head(nullptr), list_nodes(0U) {}
+    intrusivecircularlist(const intrusivecircularlist &) = delete;
+    intrusivecircularlist &operator=(const intrusivecircularlist &) = delete;
+
+    ~intrusivecircularlist()
+    {
+        clear();
+    }
+
+    /// @brief links an object at the head in O(1)
+    /// @param object object not on a list through Hook
+    /// @return false if object is already linked through Hook
+    bool linkAtBeginning(T &object)
+    {
+        if (!linkAtEnd(object))
+        {
+            return false;
+        }
+        head = &object;
+        return true;
+    }
+
+    /// @brief links an object at the tail in O(1)
+    /// @param object object not on a list through Hook
+    /// @return false if object is already linked through Hook
+    bool linkAtEnd(T &object)
+    {
+        if (head == nullptr)
+        {
+            if ((object.*Hook).isLinked())
+            {
+                return false;
+            }
+            (object.*Hook).n = (object.*Hook).p = &object;
+            head = &object;
+            list_nodes++;
+            return true;
+        }
+        return linkAfter(*(head->*Hook).p, object);
+    }
+
+    /// @brief links an object right after another in O(1)
+    /// @param position object of this list
+    /// @param object object not on a list through Hook
+    /// @return false if object is already linked through Hook
+    bool linkAfter(T &position, T &object)
+    {
+        if ((object.*Hook).isLinked())
+        {
+            return false;
+        }
+        T *next = (position.*Hook).n;
+        (object.*Hook).p = &position;
+        (object.*Hook).n = next;
+        (next->*Hook).p = &object;
+        (position.*Hook).n = &object;
+        list_nodes++;
+        return true;
+    }
+
+    /// @brief unlinks an object in O(1), through its own hook
+    /// @param object object of this list
+    /// @return false if object is not linked through Hook
+    bool unlink(T &object)
+    {
+        circlyhook<T> &hook = object.*Hook;
+        if (!hook.isLinked())
+        {
+            return false;
+        }
+        if (hook.n == &object)
+        {
+            head = nullptr; // last object
+        }
+        else
+        {
+            (hook.p->*Hook).n = hook.n;
+            (hook.n->*Hook).p = hook.p;
+            if (head == &object)
+            {
+                head = hook.n;
+            }
+        }
+        hook.n = hook.p = nullptr;
+        list_nodes--;
+        return true;
+    }
+
+    /// @brief unlinks the head in O(1)
+    /// @return the object unlinked, or null if the list is empty
+    T *removeAtBeginning()
+    {
+        T *object = head;
+        if (object != nullptr)
+        {
+            unlink(*object);
+        }
+        return object;
+    }
+
+    /// @brief unlinks the tail in O(1)
+    /// @return the object unlinked, or null if the list is empty
+    T *removeAtEnd()
+    {
+        T *object = back();
+        if (object != nullptr)
+        {
+            unlink(*object);
+        }
+        return object;
+    }
+
+    /// @brief unlinks every object pred accepts, in one lap
+    /// @param pred callable taking T & and returning true to unlink
+    /// @return number of objects unlinked
+    template <typename Predicate>
+    size_t removeIf(Predicate pred)
+    {
+        size_t removed = 0U;
+        T *current = head;
+        for (size_t i = list_nodes; i > 0; --i)
+        {
+            T *next = (current->*Hook).n;
+            if (pred(*current))
+            {
+                unlink(*current);
+                ++removed;
+            }
+            current = next;
+        }
+        return removed;
+    }
+
+    /// @brief unlinks every object
+    void clear()
+    {
+        while (removeAtBeginning() != nullptr)
+        {
+        }
+    }
+
+    /// @brief gets the first object
+    /// @return head, or null if empty
+    T *front() const
+    {
+        return head;
+    }
+
+    /// @brief gets the last object
+    /// @return tail, or null if empty
+    T *back() const
+    {
+        return head != nullptr ? (head->*Hook).p : nullptr;
+    }
+
+    /// @brief gets the object at position, walking from whichever end is closer
+    /// @param position 1-... position in the list
+    /// @return object at position, or null if out of range
+    T *getStoragePtr(size_t position) const
+    {
+        if (position < 1 || position > list_nodes)
+        {
+            return nullptr; // position out of range
+        }
+        T *current = head;
+        if (position <= list_nodes / 2U + 1U)
+        {
+            for (size_t i = 1; i < position; ++i)
+            {
+                current = (current->*Hook).n;
+            }
+        }
+        else
+        {
+            for (size_t i = list_nodes + 1U; i > position; --i)
+            {
+                current = (current->*Hook).p;
+            }
+        }
+        return current;
+    }
+
+    /// @brief gets the number of linked objects
+    /// @return object count
+    size_t size() const
+    {
+        return list_nodes;
+    }
+
+    /// @brief iterator at the head, for range-based for loops
+    iterator begin() const { return iterator(head, list_nodes); }
+
+    /// @brief iterator past the tail
+    iterator end() const { return iterator(nullptr, 0U); }
+
+    /// @brief iterator at the tail, walking back to the head
+    reverse_iterator rbegin() const { return reverse_iterator(back(), list_nodes); }
+
+    /// @brief iterator past the head
+    reverse_iterator rend() const { return reverse_iterator(nullptr, 0U); }
+
+private:
+    T *head;           ///< first object; its hook's p is the last object
+    size_t list_nodes; ///< number of linked objects
+};
+
+#endif // INTRUSIVE_LIST_H
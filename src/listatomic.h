@@ -0,0 +1,110 @@
+#ifndef LIST_ATOMIC_H
+#define LIST_ATOMIC_H
+
+#include <Arduino.h>
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+#endif
+
+/// @brief minimal atomic integer or pointer for the concurrent list types
+/// @details AVR toolchains ship no <atomic>. On AVR every operation runs with
+/// interrupts disabled, which makes it atomic with respect to interrupt
+/// handlers; elsewhere the GCC/Clang __atomic builtins are used, so values can
+/// be shared between threads. Loads acquire, stores release, and
+/// read-modify-write operations are acquire-release.
+/// @tparam T integer or pointer type
+template <typename T>
+class listatomic
+{
+public:
+    explicit listatomic(T initial = T()) : value(initial) {}
+    listatomic(const listatomic &) = delete;
+    listatomic &operator=(const listatomic &) = delete;
+
+#if defined(__AVR__)
+    T load() const
+    {
+        T current;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { current = value; }
+        return current;
+    }
+
+    void store(T desired)
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { value = desired; }
+    }
+
+    T exchange(T desired)
+    {
+        T previous;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            previous = value;
+            value = desired;
+        }
+        return previous;
+    }
+
+    bool compareExchange(T &expected, T desired)
+    {
+        bool swapped;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            swapped = value == expected;
+            if (swapped)
+            {
+                value = desired;
+            }
+            else
+            {
+                expected = value;
+            }
+        }
+        return swapped;
+    }
+
+    T fetchAdd(T delta)
+    {
+        T previous;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            previous = value;
+            value += delta;
+        }
+        return previous;
+    }
+
+    T subFetch(T delta)
+    {
+        T result;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { result = (value -= delta); }
+        return result;
+    }
+#else
+    T load() const { return __atomic_load_n(&value, __ATOMIC_ACQUIRE); }
+    void store(T desired) { __atomic_store_n(&value, desired, __ATOMIC_RELEASE); }
+    T exchange(T desired) { return __atomic_exchange_n(&value, desired, __ATOMIC_ACQ_REL); }
+    bool compareExchange(T &expected, T desired)
+    {
+        return __atomic_compare_exchange_n(&value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    }
+    T fetchAdd(T delta) { return __atomic_fetch_add(&value, delta, __ATOMIC_ACQ_REL); }
+    T subFetch(T delta) { return __atomic_sub_fetch(&value, delta, __ATOMIC_ACQ_REL); }
+#endif
+
+private:
+    T value; ///< the shared value
+};
+
+/// @brief full memory barrier between the surrounding loads and stores
+inline void listfence()
+{
+#if defined(__AVR__)
+    __asm__ __volatile__("" ::: "memory"); // single core: only the compiler reorders
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+#endif // LIST_ATOMIC_H
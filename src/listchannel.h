@@ -0,0 +1,427 @@
+#ifndef LIST_CHANNEL_H
+#define LIST_CHANNEL_H
+
+// C++20 coroutines only; the header is empty for older standards (and Arduino)
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+
+#include <Arduino.h>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include "singly.h"
+#include "intrusivelist.h"
+
+/// @brief fire-and-forget coroutine started by listexecutor::spawn()
+/// @details The coroutine starts suspended, runs when the executor gets to it
+/// and frees its own frame when it returns.
+class listtask
+{
+public:
+    struct promise_type
+    {
+        listtask get_return_object() { return listtask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    listtask(listtask &&other) noexcept : frame(other.frame) { other.frame = nullptr; }
+    listtask(const listtask &) = delete;
+    listtask &operator=(const listtask &) = delete;
+
+    /// @brief frees the frame of a task that was never spawned
+    ~listtask()
+    {
+        if (frame)
+        {
+            frame.destroy();
+        }
+    }
+
+    /// @brief hands the frame over to the caller, who resumes it
+    std::coroutine_handle<> release()
+    {
+        std::coroutine_handle<> handle = frame;
+        frame = nullptr;
+        return handle;
+    }
+
+private:
+    explicit listtask(std::coroutine_handle<promise_type> handle) : frame(handle) {}
+    std::coroutine_handle<promise_type> frame; ///< suspended at its start until released
+};
+
+/// @brief single-threaded executor: a FIFO run queue of coroutines on a singlylist
+/// @details post() queues a coroutine; run() resumes queued coroutines in order
+/// until none is left. Nothing runs in the background and nothing polls. The
+/// queue keeps its slab slots, so posting stops allocating once it has been
+/// as long as it gets.
+class listexecutor
+{
+public:
+    listexecutor() {}
+    listexecutor(const listexecutor &) = delete;
+    listexecutor &operator=(const listexecutor &) = delete;
+
+    /// @brief frees the frames still queued, which have not been resumed
+    ~listexecutor()
+    {
+        while (ready.size() > 0)
+        {
+            std::coroutine_handle<> handle = *ready.begin();
+            ready.removeAtBeginning();
+            handle.destroy();
+        }
+    }
+
+    /// @brief queues a coroutine to be resumed by run()
+    /// @param handle suspended coroutine
+    /// @return false on allocation failure
+    bool post(std::coroutine_handle<> handle)
+    {
+        return ready.insertCopyAtEnd(handle) != nullptr;
+    }
+
+    /// @brief queues a new task
+    /// @param task coroutine returning listtask
+    /// @return false on allocation failure; the task is then freed unrun
+    bool spawn(listtask task)
+    {
+        std::coroutine_handle<> handle = task.release();
+        if (!post(handle))
+        {
+            handle.destroy();
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief resumes the oldest queued coroutine
+    /// @return false if none was queued
+    bool runOnce()
+    {
+        if (ready.size() == 0)
+        {
+            return false;
+        }
+        std::coroutine_handle<> handle = *ready.begin();
+        ready.removeAtBeginning();
+        handle.resume();
+        return true;
+    }
+
+    /// @brief resumes queued coroutines, including ones they queue, until none is left
+    /// @return number of resumptions
+    size_t run()
+    {
+        size_t resumed = 0U;
+        while (runOnce())
+        {
+            ++resumed;
+        }
+        return resumed;
+    }
+
+    /// @brief gets the number of queued coroutines
+    size_t pending() const
+    {
+        return (size_t)ready.size();
+    }
+
+private:
+    basic_singlylist<slabtraits<8>, std::coroutine_handle<>> ready; ///< coroutines to resume, oldest first; slabs keep freed slots
+};
+
+/// @brief awaitable FIFO channel between coroutines, queued on a singlylist
+/// @details `co_await receive()` takes the oldest item or suspends until
+/// send() delivers one; send() hands its item straight to the longest-waiting
+/// receiver and posts it to the executor, so no side polls. With a capacity,
+/// `co_await send()` suspends while the channel is full and is resumed by the
+/// receive that makes room. Items sit in slab slots that are reused, and a
+/// bounded channel reserves its capacity up front, so a running channel stops
+/// allocating once the queue has been as long as it gets.
+///
+/// Waiting coroutines are linked into intrusive lists through their awaiters,
+/// which live in the coroutine frames, so waiting never allocates. A
+/// coroutine must not be destroyed while it waits on a channel. close() wakes
+/// every waiter; the destructor closes the channel.
+/// @tparam T item type, copy-constructible
+/// @tparam Executor type with `bool post(std::coroutine_handle<>)`
+template <typename T, typename Executor = listexecutor>
+class listchannel
+{
+    /// @brief state of a suspended receive, linked into the receivers list
+    struct receivewaiter
+    {
+        singlyhook<receivewaiter> waiting; ///< link in receivers
+        std::coroutine_handle<> handle;    ///< coroutine to resume
+        std::optional<T> *single;          ///< receive(): where the item goes
+        T *out;                            ///< receive(out, max): where items go
+        size_t max;                        ///< receive(out, max): room in out
+        size_t count;                      ///< items delivered so far
+
+        void deliver(T &&value)
+        {
+            if (single != nullptr)
+            {
+                single->emplace(std::move(value));
+            }
+            else
+            {
+                out[count] = std::move(value);
+            }
+            ++count;
+        }
+    };
+
+    /// @brief state of a suspended send, linked into the senders list
+    struct sendwaiter
+    {
+        singlyhook<sendwaiter> waiting; ///< link in senders
+        std::coroutine_handle<> handle; ///< coroutine to resume
+        std::optional<T> value;         ///< item to send
+        bool delivered;                 ///< item taken by the channel
+    };
+
+public:
+    /// @brief awaitable returned by receive(): yields the item, or nothing once closed and drained
+    class receiveawaiter
+    {
+    public:
+        receiveawaiter(listchannel &owner) : channel(owner) { state.single = &value; }
+        receiveawaiter(const receiveawaiter &) = delete;
+        receiveawaiter &operator=(const receiveawaiter &) = delete;
+        bool await_ready() { return channel.try_take(state); }
+        void await_suspend(std::coroutine_handle<> handle) { channel.wait(state, handle); }
+        std::optional<T> await_resume() { return std::move(value); }
+
+    private:
+        listchannel &channel;  ///< channel received from
+        receivewaiter state{}; ///< waiting state
+        std::optional<T> value; ///< item received
+    };
+
+    /// @brief awaitable returned by receive(out, max): yields the number of items stored
+    class batchawaiter
+    {
+    public:
+        batchawaiter(listchannel &owner, T *out, size_t max) : channel(owner)
+        {
+            state.out = out;
+            state.max = max;
+        }
+        batchawaiter(const batchawaiter &) = delete;
+        batchawaiter &operator=(const batchawaiter &) = delete;
+        bool await_ready() { return state.max == 0U || channel.try_take(state); }
+        void await_suspend(std::coroutine_handle<> handle) { channel.wait(state, handle); }
+        size_t await_resume()
+        {
+            channel.drain(state); // items sent after the first, before this coroutine ran
+            return state.count;
+        }
+
+    private:
+        listchannel &channel;  ///< channel received from
+        receivewaiter state{}; ///< waiting state
+    };
+
+    /// @brief awaitable returned by send(): yields false if the channel was closed
+    class sendawaiter
+    {
+    public:
+        sendawaiter(listchannel &owner, T &&item) : channel(owner) { state.value.emplace(std::move(item)); }
+        sendawaiter(const sendawaiter &) = delete;
+        sendawaiter &operator=(const sendawaiter &) = delete;
+        bool await_ready() { return channel.try_put(state); }
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            state.handle = handle;
+            channel.senders.linkAtEnd(state);
+        }
+        bool await_resume() { return state.delivered; }
+
+    private:
+        listchannel &channel; ///< channel sent to
+        sendwaiter state{};   ///< waiting state
+    };
+
+    /// @param executor runs the coroutines the channel wakes
+    /// @param capacity most items queued at once; 0 for no limit
+    listchannel(Executor &executor, size_t capacity = 0U) : runner(executor), bound(capacity), closed(false)
+    {
+        if (bound > 0U)
+        {
+            items.reserve((int)bound);
+        }
+    }
+
+    listchannel(const listchannel &) = delete;
+    listchannel &operator=(const listchannel &) = delete;
+
+    ~listchannel()
+    {
+        close();
+    }
+
+    /// @brief receives one item; suspends while the channel is empty
+    /// @return awaitable yielding std::optional<T>, empty once the channel is closed and drained
+    receiveawaiter receive()
+    {
+        return receiveawaiter(*this);
+    }
+
+    /// @brief receives between 1 and max items per resume; suspends while the channel is empty
+    /// @param out array of at least max constructed items
+    /// @param max most items to store
+    /// @return awaitable yielding the number of items stored, 0 once the channel is closed and drained
+    batchawaiter receive(T *out, size_t max)
+    {
+        return batchawaiter(*this, out, max);
+    }
+
+    /// @brief sends an item; suspends while a bounded channel is full
+    /// @param item item to send
+    /// @return awaitable yielding false if the channel was closed or an allocation failed
+    sendawaiter send(T item)
+    {
+        return sendawaiter(*this, std::move(item));
+    }
+
+    /// @brief sends an item without waiting, e.g. from outside a coroutine
+    /// @param item item to send
+    /// @return false if the channel is closed or full, or on allocation failure
+    bool trySend(T item)
+    {
+        sendwaiter state{};
+        state.value.emplace(std::move(item));
+        return try_put(state) && state.delivered;
+    }
+
+    /// @brief receives an item without waiting
+    /// @return the oldest item, or nothing if the channel is empty
+    std::optional<T> tryReceive()
+    {
+        std::optional<T> value;
+        receivewaiter state{};
+        state.single = &value;
+        if (items.size() > 0)
+        {
+            take_one(state);
+        }
+        return value;
+    }
+
+    /// @brief closes the channel and wakes every waiter
+    /// @details waiting senders resume with false; receivers resume with the
+    /// items still queued, then with nothing
+    void close()
+    {
+        closed = true;
+        while (sendwaiter *sender = senders.removeAtBeginning())
+        {
+            sender->delivered = false;
+            runner.post(sender->handle);
+        }
+        while (receivewaiter *receiver = receivers.removeAtBeginning())
+        {
+            runner.post(receiver->handle);
+        }
+    }
+
+    /// @brief checks whether close() was called
+    bool isClosed() const
+    {
+        return closed;
+    }
+
+    /// @brief gets the number of queued items
+    size_t size() const
+    {
+        return (size_t)items.size();
+    }
+
+    /// @brief gets the capacity, 0 for unbounded
+    size_t capacity() const
+    {
+        return bound;
+    }
+
+private:
+    /// @brief completes a send without suspending, if it can
+    /// @return false if the sender has to wait for room
+    bool try_put(sendwaiter &state)
+    {
+        if (closed)
+        {
+            state.delivered = false;
+            return true;
+        }
+        if (receivewaiter *receiver = receivers.removeAtBeginning())
+        {
+            receiver->deliver(std::move(*state.value)); // the list is empty
+            runner.post(receiver->handle);
+            state.delivered = true;
+            return true;
+        }
+        if (bound > 0U && (size_t)items.size() >= bound)
+        {
+            return false;
+        }
+        state.delivered = items.insertCopyAtEnd(std::move(*state.value)) != nullptr;
+        return true;
+    }
+
+    /// @brief takes queued items without suspending, if there are any
+    /// @return false if the receiver has to wait
+    bool try_take(receivewaiter &state)
+    {
+        if (items.size() == 0)
+        {
+            return closed;
+        }
+        drain(state);
+        return true;
+    }
+
+    /// @brief links a receiver into the waiting list
+    void wait(receivewaiter &state, std::coroutine_handle<> handle)
+    {
+        state.handle = handle;
+        receivers.linkAtEnd(state);
+    }
+
+    /// @brief moves queued items to a receiver until it is full or the list is empty
+    void drain(receivewaiter &state)
+    {
+        size_t room = state.single != nullptr ? 1U : state.max;
+        while (state.count < room && items.size() > 0)
+        {
+            take_one(state);
+        }
+    }
+
+    /// @brief moves the head item to a receiver and lets the oldest waiting sender fill the room
+    void take_one(receivewaiter &state)
+    {
+        state.deliver(std::move(*items.begin()));
+        items.removeAtBeginning();
+        if (sendwaiter *sender = senders.removeAtBeginning())
+        {
+            sender->delivered = items.insertCopyAtEnd(std::move(*sender->value)) != nullptr;
+            runner.post(sender->handle);
+        }
+    }
+
+    Executor &runner;                                          ///< resumes woken coroutines
+    basic_singlylist<slabtraits<8>, T> items;                  ///< queued items, oldest first; slabs keep freed slots
+    intrusivesinglylist<receivewaiter, &receivewaiter::waiting> receivers; ///< suspended receives, oldest first
+    intrusivesinglylist<sendwaiter, &sendwaiter::waiting> senders;          ///< suspended sends, oldest first
+    size_t bound;                                              ///< capacity, 0 for unbounded
+    bool closed;                                               ///< close() was called
+};
+
+#endif // __cpp_impl_coroutine
+
+#endif // LIST_CHANNEL_H
@@ -0,0 +1,20 @@
+#ifndef LIST_KEY_H
+#define LIST_KEY_H
+
+#include <Arduino.h>
+
+/// @brief Key policy for payloads that are their own keys
+/// @details A key policy names the key type, extracts the key from a payload
+/// and hashes it. bloomlist hashes keys, mixing the hash further, so an
+/// identity hash is fine for integers; sumaggregate and extremalist only
+/// extract keys. Write one for other payloads, e.g.
+/// `struct byid { typedef int key_type; static int key(const Reading &r) { return r.id; } static uint32_t hash(int id) { return id; } };`
+template <typename T>
+struct listkey
+{
+    typedef T key_type;
+    static const T &key(const T &payload) { return payload; }
+    static uint32_t hash(const T &key) { return (uint32_t)key; }
+};
+
+#endif // LIST_KEY_H
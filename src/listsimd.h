@@ -0,0 +1,590 @@
+#ifndef LIST_SIMD_H
+#define LIST_SIMD_H
+
+#include <Arduino.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/// @brief comparisons countIf can apply against a threshold
+enum thresholdop : uint8_t
+{
+    THRESHOLD_EQUAL,        ///< element == threshold
+    THRESHOLD_LESS,         ///< element < threshold
+    THRESHOLD_LESS_EQUAL,   ///< element <= threshold
+    THRESHOLD_GREATER,      ///< element > threshold
+    THRESHOLD_GREATER_EQUAL ///< element >= threshold
+};
+
+/// @brief accumulator type of sum(): int64_t for integers, double for floating point
+template <typename T>
+struct simdsum
+{
+    typedef int64_t type;
+};
+
+template <>
+struct simdsum<float>
+{
+    typedef double type;
+};
+
+template <>
+struct simdsum<double>
+{
+    typedef double type;
+};
+
+/// @brief vector operations for one payload type on the instruction set the
+/// build targets
+/// @details Specialised below for int16_t, int32_t and float on AVX2, SSE2 and
+/// AArch64 NEON, whichever the compiler enables first; every other type and
+/// target uses the scalar kernels. bits() packs a comparison mask into one bit
+/// per lane, lane 0 in bit 0.
+template <typename T>
+struct simdops
+{
+    static const bool vectorized = false;
+};
+
+#if defined(__AVX2__)
+
+template <>
+struct simdops<int32_t>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 8U;
+    typedef __m256i vec;
+    typedef __m256i mask;
+    static vec load(const int32_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static void store(int32_t *p, vec a) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a); }
+    static vec splat(int32_t x) { return _mm256_set1_epi32(x); }
+    static mask eq(vec a, vec b) { return _mm256_cmpeq_epi32(a, b); }
+    static mask lt(vec a, vec b) { return _mm256_cmpgt_epi32(b, a); }
+    static mask gt(vec a, vec b) { return _mm256_cmpgt_epi32(a, b); }
+    static mask le(vec a, vec b) { return _mm256_xor_si256(gt(a, b), _mm256_set1_epi32(-1)); }
+    static mask ge(vec a, vec b) { return _mm256_xor_si256(lt(a, b), _mm256_set1_epi32(-1)); }
+    static unsigned bits(mask m) { return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(m)); }
+    static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+    static int64_t sum(const int32_t *p, size_t blocks)
+    {
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p))));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 4))));
+        }
+        int64_t part[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(part), acc);
+        return part[0] + part[1] + part[2] + part[3];
+    }
+};
+
+template <>
+struct simdops<int16_t>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 16U;
+    typedef __m256i vec;
+    typedef __m256i mask;
+    static vec load(const int16_t *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static void store(int16_t *p, vec a) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), a); }
+    static vec splat(int16_t x) { return _mm256_set1_epi16(x); }
+    static mask eq(vec a, vec b) { return _mm256_cmpeq_epi16(a, b); }
+    static mask lt(vec a, vec b) { return _mm256_cmpgt_epi16(b, a); }
+    static mask gt(vec a, vec b) { return _mm256_cmpgt_epi16(a, b); }
+    static mask le(vec a, vec b) { return _mm256_xor_si256(gt(a, b), _mm256_set1_epi16(-1)); }
+    static mask ge(vec a, vec b) { return _mm256_xor_si256(lt(a, b), _mm256_set1_epi16(-1)); }
+    static unsigned bits(mask m)
+    {
+        // packing works per 128-bit half: lanes 0-7 land in bits 0-7, lanes 8-15 in bits 16-23
+        unsigned packed = (unsigned)_mm256_movemask_epi8(_mm256_packs_epi16(m, _mm256_setzero_si256()));
+        return (packed & 0xFFU) | ((packed >> 8) & 0xFF00U);
+    }
+    static vec min(vec a, vec b) { return _mm256_min_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_epi16(a, b); }
+    static int64_t sum(const int16_t *p, size_t blocks)
+    {
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            __m256i pairs = _mm256_madd_epi16(load(p), ones); // eight int32 pair sums
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(pairs)));
+            acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(pairs, 1)));
+        }
+        int64_t part[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(part), acc);
+        return part[0] + part[1] + part[2] + part[3];
+    }
+};
+
+template <>
+struct simdops<float>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 8U;
+    typedef __m256 vec;
+    typedef __m256 mask;
+    static vec load(const float *p) { return _mm256_loadu_ps(p); }
+    static void store(float *p, vec a) { _mm256_storeu_ps(p, a); }
+    static vec splat(float x) { return _mm256_set1_ps(x); }
+    static mask eq(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static mask lt(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static mask gt(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static mask le(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static mask ge(vec a, vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static unsigned bits(mask m) { return (unsigned)_mm256_movemask_ps(m); }
+    static vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+    static vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+    static double sum(const float *p, size_t blocks)
+    {
+        __m256d acc = _mm256_setzero_pd();
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(p)));
+            acc = _mm256_add_pd(acc, _mm256_cvtps_pd(_mm_loadu_ps(p + 4)));
+        }
+        double part[4];
+        _mm256_storeu_pd(part, acc);
+        return part[0] + part[1] + part[2] + part[3];
+    }
+};
+
+#elif defined(__SSE2__)
+
+template <>
+struct simdops<int32_t>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 4U;
+    typedef __m128i vec;
+    typedef __m128i mask;
+    static vec load(const int32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static void store(int32_t *p, vec a) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a); }
+    static vec splat(int32_t x) { return _mm_set1_epi32(x); }
+    static mask eq(vec a, vec b) { return _mm_cmpeq_epi32(a, b); }
+    static mask lt(vec a, vec b) { return _mm_cmplt_epi32(a, b); }
+    static mask gt(vec a, vec b) { return _mm_cmpgt_epi32(a, b); }
+    static mask le(vec a, vec b) { return _mm_xor_si128(gt(a, b), _mm_set1_epi32(-1)); }
+    static mask ge(vec a, vec b) { return _mm_xor_si128(lt(a, b), _mm_set1_epi32(-1)); }
+    static unsigned bits(mask m) { return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(m)); }
+    static vec select(mask m, vec a, vec b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+    static vec min(vec a, vec b) { return select(lt(a, b), a, b); } // SSE2 has no 32-bit min
+    static vec max(vec a, vec b) { return select(gt(a, b), a, b); }
+    static int64_t sum(const int32_t *p, size_t blocks)
+    {
+        __m128i acc = _mm_setzero_si128();
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            __m128i v = load(p);
+            __m128i sign = _mm_srai_epi32(v, 31); // sign-extend to 64 bits
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, sign));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, sign));
+        }
+        int64_t part[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(part), acc);
+        return part[0] + part[1];
+    }
+};
+
+template <>
+struct simdops<int16_t>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 8U;
+    typedef __m128i vec;
+    typedef __m128i mask;
+    static vec load(const int16_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static void store(int16_t *p, vec a) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), a); }
+    static vec splat(int16_t x) { return _mm_set1_epi16(x); }
+    static mask eq(vec a, vec b) { return _mm_cmpeq_epi16(a, b); }
+    static mask lt(vec a, vec b) { return _mm_cmplt_epi16(a, b); }
+    static mask gt(vec a, vec b) { return _mm_cmpgt_epi16(a, b); }
+    static mask le(vec a, vec b) { return _mm_xor_si128(gt(a, b), _mm_set1_epi16(-1)); }
+    static mask ge(vec a, vec b) { return _mm_xor_si128(lt(a, b), _mm_set1_epi16(-1)); }
+    static unsigned bits(mask m) { return (unsigned)_mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128())); }
+    static vec min(vec a, vec b) { return _mm_min_epi16(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_epi16(a, b); }
+    static int64_t sum(const int16_t *p, size_t blocks)
+    {
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i acc = _mm_setzero_si128();
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            __m128i pairs = _mm_madd_epi16(load(p), ones); // four int32 pair sums
+            __m128i sign = _mm_srai_epi32(pairs, 31);
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(pairs, sign));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(pairs, sign));
+        }
+        int64_t part[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(part), acc);
+        return part[0] + part[1];
+    }
+};
+
+template <>
+struct simdops<float>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 4U;
+    typedef __m128 vec;
+    typedef __m128 mask;
+    static vec load(const float *p) { return _mm_loadu_ps(p); }
+    static void store(float *p, vec a) { _mm_storeu_ps(p, a); }
+    static vec splat(float x) { return _mm_set1_ps(x); }
+    static mask eq(vec a, vec b) { return _mm_cmpeq_ps(a, b); }
+    static mask lt(vec a, vec b) { return _mm_cmplt_ps(a, b); }
+    static mask gt(vec a, vec b) { return _mm_cmpgt_ps(a, b); }
+    static mask le(vec a, vec b) { return _mm_cmple_ps(a, b); }
+    static mask ge(vec a, vec b) { return _mm_cmpge_ps(a, b); }
+    static unsigned bits(mask m) { return (unsigned)_mm_movemask_ps(m); }
+    static vec min(vec a, vec b) { return _mm_min_ps(a, b); }
+    static vec max(vec a, vec b) { return _mm_max_ps(a, b); }
+    static double sum(const float *p, size_t blocks)
+    {
+        __m128d acc = _mm_setzero_pd();
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            __m128 v = load(p);
+            acc = _mm_add_pd(acc, _mm_cvtps_pd(v));
+            acc = _mm_add_pd(acc, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+        }
+        double part[2];
+        _mm_storeu_pd(part, acc);
+        return part[0] + part[1];
+    }
+};
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+template <>
+struct simdops<int32_t>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 4U;
+    typedef int32x4_t vec;
+    typedef uint32x4_t mask;
+    static vec load(const int32_t *p) { return vld1q_s32(p); }
+    static void store(int32_t *p, vec a) { vst1q_s32(p, a); }
+    static vec splat(int32_t x) { return vdupq_n_s32(x); }
+    static mask eq(vec a, vec b) { return vceqq_s32(a, b); }
+    static mask lt(vec a, vec b) { return vcltq_s32(a, b); }
+    static mask gt(vec a, vec b) { return vcgtq_s32(a, b); }
+    static mask le(vec a, vec b) { return vcleq_s32(a, b); }
+    static mask ge(vec a, vec b) { return vcgeq_s32(a, b); }
+    static unsigned bits(mask m)
+    {
+        static const uint32_t weights[4] = {1U, 2U, 4U, 8U};
+        return vaddvq_u32(vandq_u32(m, vld1q_u32(weights)));
+    }
+    static vec min(vec a, vec b) { return vminq_s32(a, b); }
+    static vec max(vec a, vec b) { return vmaxq_s32(a, b); }
+    static int64_t sum(const int32_t *p, size_t blocks)
+    {
+        int64x2_t acc = vdupq_n_s64(0);
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            acc = vpadalq_s32(acc, load(p));
+        }
+        return vaddvq_s64(acc);
+    }
+};
+
+template <>
+struct simdops<int16_t>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 8U;
+    typedef int16x8_t vec;
+    typedef uint16x8_t mask;
+    static vec load(const int16_t *p) { return vld1q_s16(p); }
+    static void store(int16_t *p, vec a) { vst1q_s16(p, a); }
+    static vec splat(int16_t x) { return vdupq_n_s16(x); }
+    static mask eq(vec a, vec b) { return vceqq_s16(a, b); }
+    static mask lt(vec a, vec b) { return vcltq_s16(a, b); }
+    static mask gt(vec a, vec b) { return vcgtq_s16(a, b); }
+    static mask le(vec a, vec b) { return vcleq_s16(a, b); }
+    static mask ge(vec a, vec b) { return vcgeq_s16(a, b); }
+    static unsigned bits(mask m)
+    {
+        static const uint16_t weights[8] = {1U, 2U, 4U, 8U, 16U, 32U, 64U, 128U};
+        return vaddvq_u16(vandq_u16(m, vld1q_u16(weights)));
+    }
+    static vec min(vec a, vec b) { return vminq_s16(a, b); }
+    static vec max(vec a, vec b) { return vmaxq_s16(a, b); }
+    static int64_t sum(const int16_t *p, size_t blocks)
+    {
+        int64x2_t acc = vdupq_n_s64(0);
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            acc = vpadalq_s32(acc, vpaddlq_s16(load(p)));
+        }
+        return vaddvq_s64(acc);
+    }
+};
+
+template <>
+struct simdops<float>
+{
+    static const bool vectorized = true;
+    static const uint8_t lanes = 4U;
+    typedef float32x4_t vec;
+    typedef uint32x4_t mask;
+    static vec load(const float *p) { return vld1q_f32(p); }
+    static void store(float *p, vec a) { vst1q_f32(p, a); }
+    static vec splat(float x) { return vdupq_n_f32(x); }
+    static mask eq(vec a, vec b) { return vceqq_f32(a, b); }
+    static mask lt(vec a, vec b) { return vcltq_f32(a, b); }
+    static mask gt(vec a, vec b) { return vcgtq_f32(a, b); }
+    static mask le(vec a, vec b) { return vcleq_f32(a, b); }
+    static mask ge(vec a, vec b) { return vcgeq_f32(a, b); }
+    static unsigned bits(mask m)
+    {
+        static const uint32_t weights[4] = {1U, 2U, 4U, 8U};
+        return vaddvq_u32(vandq_u32(m, vld1q_u32(weights)));
+    }
+    static vec min(vec a, vec b) { return vminq_f32(a, b); }
+    static vec max(vec a, vec b) { return vmaxq_f32(a, b); }
+    static double sum(const float *p, size_t blocks)
+    {
+        float64x2_t acc = vdupq_n_f64(0.0);
+        for (size_t i = 0; i < blocks; ++i, p += lanes)
+        {
+            float32x4_t v = load(p);
+            acc = vaddq_f64(acc, vcvt_f64_f32(vget_low_f32(v)));
+            acc = vaddq_f64(acc, vcvt_high_f64_f32(v));
+        }
+        return vaddvq_f64(acc);
+    }
+};
+
+#endif
+
+/// @brief search and reduction kernels over a contiguous run of payloads
+/// @details The scalar version, used for every type and target without a
+/// simdops specialisation and for the tails of the vector version.
+/// @tparam T arithmetic payload type
+template <typename T, bool Vectorized = simdops<T>::vectorized>
+struct listsimd
+{
+    /// @brief finds the first element equal to value
+    /// @return index of the element, or count if there is none
+    static size_t find(const T *data, size_t count, T value)
+    {
+        size_t i = 0;
+        while (i < count && !(data[i] == value))
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    /// @brief counts the elements that compare true against threshold
+    static size_t countIf(const T *data, size_t count, thresholdop op, T threshold)
+    {
+        size_t matched = 0U;
+        for (size_t i = 0; i < count; ++i)
+        {
+            matched += matches(data[i], op, threshold) ? 1U : 0U;
+        }
+        return matched;
+    }
+
+    /// @brief smallest element; count must be at least 1
+    static T min(const T *data, size_t count)
+    {
+        T result = data[0];
+        for (size_t i = 1; i < count; ++i)
+        {
+            result = data[i] < result ? data[i] : result;
+        }
+        return result;
+    }
+
+    /// @brief largest element; count must be at least 1
+    static T max(const T *data, size_t count)
+    {
+        T result = data[0];
+        for (size_t i = 1; i < count; ++i)
+        {
+            result = result < data[i] ? data[i] : result;
+        }
+        return result;
+    }
+
+    /// @brief total of the elements, accumulated in simdsum<T>::type
+    static typename simdsum<T>::type sum(const T *data, size_t count)
+    {
+        typename simdsum<T>::type total = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            total += data[i];
+        }
+        return total;
+    }
+
+    /// @brief applies one threshold comparison
+    static bool matches(T value, thresholdop op, T threshold)
+    {
+        switch (op)
+        {
+        case THRESHOLD_EQUAL:
+            return value == threshold;
+        case THRESHOLD_LESS:
+            return value < threshold;
+        case THRESHOLD_LESS_EQUAL:
+            return value <= threshold;
+        case THRESHOLD_GREATER:
+            return value > threshold;
+        default:
+            return value >= threshold;
+        }
+    }
+};
+
+/// @brief vector kernels: whole blocks of simdops<T>::lanes elements, then a scalar tail
+template <typename T>
+struct listsimd<T, true>
+{
+    typedef simdops<T> ops;
+    typedef listsimd<T, false> scalar;
+    static const uint8_t lanes = ops::lanes;
+
+    static size_t find(const T *data, size_t count, T value)
+    {
+        typename ops::vec wanted = ops::splat(value);
+        size_t i = 0;
+        for (; i + lanes <= count; i += lanes)
+        {
+            unsigned hits = ops::bits(ops::eq(ops::load(data + i), wanted));
+            if (hits != 0U)
+            {
+                return i + (size_t)__builtin_ctz(hits);
+            }
+        }
+        return i + scalar::find(data + i, count - i, value);
+    }
+
+    static size_t countIf(const T *data, size_t count, thresholdop op, T threshold)
+    {
+        switch (op)
+        {
+        case THRESHOLD_EQUAL:
+            return count_blocks<&ops::eq>(data, count, threshold) + tail(data, count, op, threshold);
+        case THRESHOLD_LESS:
+            return count_blocks<&ops::lt>(data, count, threshold) + tail(data, count, op, threshold);
+        case THRESHOLD_LESS_EQUAL:
+            return count_blocks<&ops::le>(data, count, threshold) + tail(data, count, op, threshold);
+        case THRESHOLD_GREATER:
+            return count_blocks<&ops::gt>(data, count, threshold) + tail(data, count, op, threshold);
+        default:
+            return count_blocks<&ops::ge>(data, count, threshold) + tail(data, count, op, threshold);
+        }
+    }
+
+    static T min(const T *data, size_t count)
+    {
+        if (count < lanes)
+        {
+            return scalar::min(data, count);
+        }
+        typename ops::vec best = ops::load(data);
+        size_t i = lanes;
+        for (; i + lanes <= count; i += lanes)
+        {
+            best = ops::min(best, ops::load(data + i));
+        }
+        T lane[lanes];
+        ops::store(lane, best);
+        T result = scalar::min(lane, lanes);
+        if (i < count)
+        {
+            T rest = scalar::min(data + i, count - i);
+            result = rest < result ? rest : result;
+        }
+        return result;
+    }
+
+    static T max(const T *data, size_t count)
+    {
+        if (count < lanes)
+        {
+            return scalar::max(data, count);
+        }
+        typename ops::vec best = ops::load(data);
+        size_t i = lanes;
+        for (; i + lanes <= count; i += lanes)
+        {
+            best = ops::max(best, ops::load(data + i));
+        }
+        T lane[lanes];
+        ops::store(lane, best);
+        T result = scalar::max(lane, lanes);
+        if (i < count)
+        {
+            T rest = scalar::max(data + i, count - i);
+            result = result < rest ? rest : result;
+        }
+        return result;
+    }
+
+    static typename simdsum<T>::type sum(const T *data, size_t count)
+    {
+        size_t blocks = count / lanes;
+        return ops::sum(data, blocks) + scalar::sum(data + blocks * lanes, count - blocks * lanes);
+    }
+
+private:
+    /// @brief counts the matches in the whole blocks
+    /// @details lane masks are packed into a 64-bit word and counted a word at a time
+    template <typename ops::mask (*Compare)(typename ops::vec, typename ops::vec)>
+    static size_t count_blocks(const T *data, size_t count, T threshold)
+    {
+        typename ops::vec limit = ops::splat(threshold);
+        size_t matched = 0U;
+        uint64_t packed = 0U;
+        unsigned shift = 0U;
+        for (size_t i = 0; i + lanes <= count; i += lanes)
+        {
+            packed |= (uint64_t)ops::bits(Compare(ops::load(data + i), limit)) << shift;
+            shift += lanes;
+            if (shift == 64U)
+            {
+                matched += popcount(packed);
+                packed = 0U;
+                shift = 0U;
+            }
+        }
+        return matched + popcount(packed);
+    }
+
+    /// @brief counts the set bits of a word
+    static size_t popcount(uint64_t bits)
+    {
+#if defined(__POPCNT__) || defined(__aarch64__)
+        return (size_t)__builtin_popcountll(bits);
+#else
+        // without POPCNT __builtin_popcountll is a library call
+        bits = bits - ((bits >> 1) & 0x5555555555555555ULL);
+        bits = (bits & 0x3333333333333333ULL) + ((bits >> 2) & 0x3333333333333333ULL);
+        bits = (bits + (bits >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        return (size_t)((bits * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    /// @brief counts the matches in the elements after the last whole block
+    static size_t tail(const T *data, size_t count, thresholdop op, T threshold)
+    {
+        size_t done = count - count % lanes;
+        return scalar::countIf(data + done, count - done, op, threshold);
+    }
+};
+
+#endif // LIST_SIMD_H
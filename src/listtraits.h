@@ -0,0 +1,86 @@
+#ifndef LIST_TRAITS_H
+#define LIST_TRAITS_H
+
+#include <Arduino.h>
+
+/// @brief default list configuration
+/// @details Derive from listtraits and shadow members to tune a list, e.g.
+/// `struct smalllist : listtraits { static const uint8_t inline_nodes = 8; };`
+/// then use `basic_singlylist<smalllist, T, Args...>`.
+struct listtraits
+{
+    /// @brief type of the node count and of 1-based positions
+    /// @details any integer type; uint8_t or uint16_t shrink the list object on
+    /// 8-bit targets and cap the list at 255 or 65535 nodes. With an unsigned
+    /// type, negative positions wrap to large values and are out of range.
+    typedef int size_type;
+
+    /// @brief number of node slots embedded in the list object
+    /// @details the first inline_nodes nodes never touch the heap; freed inline
+    /// slots are reused before any heap allocation
+    static const uint8_t inline_nodes = 0;
+
+    /// @brief how many nodes ahead of a walk to prefetch; 0 disables prefetching
+    /// @details applies to positional lookup, clear() and iteration. Worth
+    /// enabling only for lists much larger than the cache on cores with a
+    /// prefetch instruction; on AVR the prefetch compiles to nothing.
+    static const uint8_t prefetch_distance = 0;
+
+    /// @brief heap slots in the first slab; 0 allocates every heap slot on its own
+    /// @details with slabs, heap slots are carved from blocks of slab_slots
+    /// slots, each further block twice the size of the last (up to 64 times
+    /// slab_slots). Freed slots stay in their slab for the next insert, so
+    /// steady insert/delete churn makes no allocator calls; shrink_to_fit()
+    /// frees the slabs none of whose slots hold a node. Nodes of a slab list
+    /// cannot be spliced into another list.
+    static const uint16_t slab_slots = 0;
+
+    /// @brief whether reserve() can preallocate heap slots
+    /// @details a reservable list keeps a list of spare heap slots, its count
+    /// and the reserved capacity, a pointer and two size_types more in the
+    /// list object. Lists with slabs always keep spare slots and can reserve.
+    static const bool reservable = false;
+};
+
+/// @brief largest value representable by an integer size_type
+template <typename SizeType>
+struct sizelimit
+{
+    static const SizeType max = (SizeType)(~0ULL >> (64U - 8U * sizeof(SizeType) + (SizeType(-1) < SizeType(0) ? 1U : 0U)));
+};
+
+/// @brief listtraits with count/position type SizeType
+template <typename SizeType>
+struct sizetraits : listtraits
+{
+    typedef SizeType size_type; ///< node count and position type
+};
+
+/// @brief listtraits with InlineNodes embedded node slots
+template <uint8_t InlineNodes>
+struct inlinetraits : listtraits
+{
+    static const uint8_t inline_nodes = InlineNodes; ///< embedded node slots
+};
+
+/// @brief listtraits that prefetch Distance nodes ahead of every walk
+template <uint8_t Distance>
+struct prefetchtraits : listtraits
+{
+    static const uint8_t prefetch_distance = Distance; ///< nodes prefetched ahead
+};
+
+/// @brief listtraits that allocate heap slots in slabs, the first SlabSlots slots long
+template <uint16_t SlabSlots>
+struct slabtraits : listtraits
+{
+    static const uint16_t slab_slots = SlabSlots; ///< slots in the first slab
+};
+
+/// @brief listtraits whose lists can reserve() heap slots ahead of time
+struct reservetraits : listtraits
+{
+    static const bool reservable = true; ///< keep spare heap slots
+};
+
+#endif // LIST_TRAITS_H
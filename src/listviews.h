@@ -0,0 +1,292 @@
+#ifndef LIST_VIEWS_H
+#define LIST_VIEWS_H
+
+#include <Arduino.h>
+
+/// @brief unevaluated stand-in for std::declval, which AVR toolchains lack
+template <typename T>
+T &&viewdeclval();
+
+template <typename Base, typename Predicate>
+class filterview;
+template <typename Base, typename Function>
+class mapview;
+template <typename Base>
+class takeview;
+template <typename Base>
+class skipview;
+template <typename List>
+class reverseview;
+
+/// @brief adaptor and terminal operations shared by every view
+/// @details Views are lazy: nothing is visited until the view is iterated, and
+/// a chain of adaptors is walked in a single fused pass. Adaptors keep a copy
+/// of the view they wrap, so the outermost view must outlive its iterators.
+/// @tparam Derived the concrete view
+template <typename Derived>
+class viewops
+{
+public:
+    /// @brief keeps only the elements pred accepts
+    /// @param pred callable taking an element and returning bool
+    template <typename Predicate>
+    filterview<Derived, Predicate> filter(Predicate pred) const
+    {
+        return filterview<Derived, Predicate>(self(), pred);
+    }
+
+    /// @brief transforms each element with fn
+    /// @param fn callable taking an element; its result is the new element
+    template <typename Function>
+    mapview<Derived, Function> map(Function fn) const
+    {
+        return mapview<Derived, Function>(self(), fn);
+    }
+
+    /// @brief stops after the first count elements
+    /// @param count number of elements to keep
+    takeview<Derived> take(size_t count) const
+    {
+        return takeview<Derived>(self(), count);
+    }
+
+    /// @brief drops the first count elements
+    /// @param count number of elements to drop
+    skipview<Derived> skip(size_t count) const
+    {
+        return skipview<Derived>(self(), count);
+    }
+
+    /// @brief combines every element into an accumulator
+    /// @param init initial accumulator value
+    /// @param op callable taking (accumulator, element) and returning the new accumulator
+    /// @return the final accumulator
+    template <typename T, typename Operation>
+    T fold(T init, Operation op) const
+    {
+        for (typename Derived::iterator it = self().begin(), last = self().end(); it != last; ++it)
+        {
+            init = op(init, *it);
+        }
+        return init;
+    }
+
+    /// @brief counts the elements of the view
+    /// @return element count
+    size_t count() const
+    {
+        size_t elements = 0U;
+        for (typename Derived::iterator it = self().begin(), last = self().end(); it != last; ++it)
+        {
+            ++elements;
+        }
+        return elements;
+    }
+
+private:
+    const Derived &self() const { return static_cast<const Derived &>(*this); }
+};
+
+/// @brief view over the payloads of a list, head to tail
+template <typename List>
+class listview : public viewops<listview<List> >
+{
+public:
+    typedef typename List::iterator iterator; ///< the list's own iterator
+
+    /// @param viewed list to view
+    explicit listview(List &viewed) : list(&viewed) {}
+    iterator begin() const { return list->begin(); }
+    iterator end() const { return list->end(); }
+
+    /// @brief views the list tail to head; only for lists with rbegin()/rend()
+    template <typename L = List>
+    reverseview<L> reverse() const
+    {
+        return reverseview<L>(*list);
+    }
+
+private:
+    List *list; ///< viewed list
+};
+
+/// @brief view over the payloads of a list, tail to head
+template <typename List>
+class reverseview : public viewops<reverseview<List> >
+{
+public:
+    typedef typename List::reverse_iterator iterator; ///< the list's backward iterator
+
+    /// @param viewed list to view
+    explicit reverseview(List &viewed) : list(&viewed) {}
+    iterator begin() const { return list->rbegin(); }
+    iterator end() const { return list->rend(); }
+
+private:
+    List *list; ///< viewed list
+};
+
+/// @brief view keeping the elements of Base accepted by Predicate
+template <typename Base, typename Predicate>
+class filterview : public viewops<filterview<Base, Predicate> >
+{
+    typedef typename Base::iterator base_iterator;
+
+public:
+    /// @brief iterator that skips the elements the predicate rejects
+    class iterator
+    {
+    public:
+        iterator(base_iterator at, base_iterator end, const Predicate *accept) : current(at), last(end), pred(accept)
+        {
+            settle();
+        }
+        auto operator*() const -> decltype(*viewdeclval<const base_iterator &>()) { return *current; }
+        iterator &operator++()
+        {
+            ++current;
+            settle();
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return current == other.current; }
+        bool operator!=(const iterator &other) const { return current != other.current; }
+
+    private:
+        /// @brief advances to the next accepted element or the end
+        void settle()
+        {
+            while (current != last && !(*pred)(*current))
+            {
+                ++current;
+            }
+        }
+        base_iterator current;  ///< position in Base
+        base_iterator last;     ///< end of Base
+        const Predicate *pred;  ///< predicate owned by the view
+    };
+
+    filterview(const Base &viewed, Predicate accept) : base(viewed), pred(accept) {}
+    iterator begin() const { return iterator(base.begin(), base.end(), &pred); }
+    iterator end() const { return iterator(base.end(), base.end(), &pred); }
+
+private:
+    Base base;      ///< filtered view
+    Predicate pred; ///< element filter
+};
+
+/// @brief view yielding Function applied to each element of Base
+template <typename Base, typename Function>
+class mapview : public viewops<mapview<Base, Function> >
+{
+    typedef typename Base::iterator base_iterator;
+
+public:
+    /// @brief iterator that transforms elements as they are read
+    class iterator
+    {
+    public:
+        iterator(base_iterator at, const Function *transform) : current(at), fn(transform) {}
+        auto operator*() const -> decltype(viewdeclval<const Function &>()(*viewdeclval<const base_iterator &>()))
+        {
+            return (*fn)(*current);
+        }
+        iterator &operator++()
+        {
+            ++current;
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return current == other.current; }
+        bool operator!=(const iterator &other) const { return current != other.current; }
+
+    private:
+        base_iterator current; ///< position in Base
+        const Function *fn;    ///< transform owned by the view
+    };
+
+    mapview(const Base &viewed, Function transform) : base(viewed), fn(transform) {}
+    iterator begin() const { return iterator(base.begin(), &fn); }
+    iterator end() const { return iterator(base.end(), &fn); }
+
+private:
+    Base base;   ///< mapped view
+    Function fn; ///< element transform
+};
+
+/// @brief view of at most the first count elements of Base
+template <typename Base>
+class takeview : public viewops<takeview<Base> >
+{
+    typedef typename Base::iterator base_iterator;
+
+public:
+    /// @brief iterator that reaches the end after count elements
+    class iterator
+    {
+    public:
+        iterator(base_iterator at, base_iterator end, size_t count) : current(at), last(end), remaining(count) {}
+        auto operator*() const -> decltype(*viewdeclval<const base_iterator &>()) { return *current; }
+        iterator &operator++()
+        {
+            if (--remaining > 0U) // never walks Base past the last element taken
+            {
+                ++current;
+            }
+            return *this;
+        }
+        bool operator==(const iterator &other) const
+        {
+            return done() || other.done() ? done() == other.done() : current == other.current;
+        }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    private:
+        bool done() const { return remaining == 0U || current == last; }
+        base_iterator current; ///< position in Base
+        base_iterator last;    ///< end of Base
+        size_t remaining;      ///< elements still to yield
+    };
+
+    takeview(const Base &viewed, size_t count) : base(viewed), limit(count) {}
+    iterator begin() const { return iterator(base.begin(), base.end(), limit); }
+    iterator end() const { return iterator(base.end(), base.end(), 0U); }
+
+private:
+    Base base;    ///< truncated view
+    size_t limit; ///< elements to keep
+};
+
+/// @brief view of Base without its first count elements
+template <typename Base>
+class skipview : public viewops<skipview<Base> >
+{
+public:
+    typedef typename Base::iterator iterator; ///< Base's iterator, started later
+
+    skipview(const Base &viewed, size_t count) : base(viewed), skipped(count) {}
+    iterator begin() const
+    {
+        iterator it = base.begin();
+        iterator last = base.end();
+        for (size_t i = 0; i < skipped && it != last; ++i)
+        {
+            ++it;
+        }
+        return it;
+    }
+    iterator end() const { return base.end(); }
+
+private:
+    Base base;      ///< view to skip into
+    size_t skipped; ///< elements to drop
+};
+
+/// @brief starts a lazy view over a list
+/// @param list singlylist, circulardoublylist, staticlist or any basic_ variant
+/// @return view of the list's payloads, head to tail
+template <typename List>
+listview<List> view(List &list)
+{
+    return listview<List>(list);
+}
+
+#endif // LIST_VIEWS_H
@@ -0,0 +1,889 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <Arduino.h>
+#include <new>
+#include "listtraits.h"
+
+/// @brief copy-constructs or assigns payloads
+/// @details specialised below to a plain memcpy for trivially copyable payloads
+template <bool TriviallyCopyable>
+struct payloadcopier
+{
+    template <typename NodeStorageType>
+    static NodeStorageType *copy(void *destination, const NodeStorageType &value)
+    {
+        return new (destination) NodeStorageType(value);
+    }
+
+    template <typename NodeStorageType>
+    static void assign(NodeStorageType &destination, const NodeStorageType &value)
+    {
+        destination = value;
+    }
+
+    template <typename NodeStorageType>
+    static void assign_block(NodeStorageType *destination, const NodeStorageType *values, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            destination[i] = values[i];
+        }
+    }
+};
+
+template <>
+struct payloadcopier<true>
+{
+    template <typename NodeStorageType>
+    static NodeStorageType *copy(void *destination, const NodeStorageType &value)
+    {
+        memcpy(destination, &value, sizeof(NodeStorageType));
+        return static_cast<NodeStorageType *>(destination);
+    }
+
+    template <typename NodeStorageType>
+    static void assign(NodeStorageType &destination, const NodeStorageType &value)
+    {
+        memcpy(&destination, &value, sizeof(NodeStorageType));
+    }
+
+    template <typename NodeStorageType>
+    static void assign_block(NodeStorageType *destination, const NodeStorageType *values, size_t count)
+    {
+        memcpy(destination, values, sizeof(NodeStorageType) * count);
+    }
+};
+
+/// @brief copies value into raw storage, using memcpy when the type allows it
+/// @param destination uninitialised storage for one NodeStorageType
+/// @param value payload to copy
+/// @return pointer to the new payload
+template <typename NodeStorageType>
+NodeStorageType *copy_payload(void *destination, const NodeStorageType &value)
+{
+    return payloadcopier<__is_trivially_copyable(NodeStorageType)>::copy(destination, value);
+}
+
+/// @brief assigns value to an existing payload, using memcpy when the type allows it
+/// @param destination constructed payload to overwrite
+/// @param value payload to copy
+template <typename NodeStorageType>
+void assign_payload(NodeStorageType &destination, const NodeStorageType &value)
+{
+    payloadcopier<__is_trivially_copyable(NodeStorageType)>::assign(destination, value);
+}
+
+/// @brief assigns a contiguous run of payloads, as one memcpy when the type allows it
+/// @param destination count constructed payloads to overwrite
+/// @param values count payloads to copy
+/// @param count number of payloads
+template <typename NodeStorageType>
+void assign_payloads(NodeStorageType *destination, const NodeStorageType *values, size_t count)
+{
+    payloadcopier<__is_trivially_copyable(NodeStorageType)>::assign_block(destination, values, count);
+}
+
+/// @brief bytes held by a list, see memoryUsage()
+/// @details payloads that allocate memory of their own (e.g. String) are
+/// counted at sizeof only
+struct listmemory
+{
+    size_t object;   ///< the list object itself, excluding its inline slots
+    size_t nodes;    ///< links of the list members, including slot padding
+    size_t payloads; ///< payloads of the list members
+    size_t unused;   ///< slots held without a member: spare heap slots and free inline slots
+    size_t overhead; ///< estimated heap allocator bookkeeping of the heap slots
+
+    /// @brief sum of every field
+    size_t total() const
+    {
+        return object + nodes + payloads + unused + overhead;
+    }
+};
+
+/// @brief estimates the bytes a heap allocator adds to one allocation
+/// @details avr-libc keeps a 2-byte size header. newlib and glibc keep a
+/// size_t header, round blocks up to two size_ts and never hand out fewer than
+/// four size_ts, so a small block costs 8 bytes extra on 32-bit targets and 8
+/// to 24 on 64-bit hosts.
+/// @param bytes requested allocation size
+/// @return bytes used beyond the request
+inline size_t heap_overhead(size_t bytes)
+{
+#if defined(__AVR__)
+    return bytes < 2U ? 4U - bytes : 2U;
+#else
+    const size_t header = sizeof(size_t);
+    const size_t align = 2U * sizeof(size_t);
+    size_t block = (bytes + header + align - 1U) & ~(align - 1U);
+    return (block < 4U * sizeof(size_t) ? 4U * sizeof(size_t) : block) - bytes;
+#endif
+}
+
+/// @brief one list node and the raw storage for its payload, allocated as a unit
+template <typename Node, typename NodeStorageType>
+struct nodeslot
+{
+    /// @brief links the node to the (still unconstructed) payload storage
+    nodeslot() : node(reinterpret_cast<NodeStorageType *>(storage)) {}
+    Node node;                                                               ///< list node, sp points at storage
+    alignas(NodeStorageType) unsigned char storage[sizeof(NodeStorageType)]; ///< payload bytes
+};
+
+/// @brief runs Distance links ahead of a traversal, prefetching each node slot
+/// @details The slot holds both the node and its payload, so prefetching the
+/// slot needs no dependent load of sp. The lead stops after `steps` links, so it
+/// never touches nodes the traversal will not reach.
+template <typename Node, typename NodeStorageType, Node *Node::*Link, uint8_t Distance>
+class prefetchcursor
+{
+public:
+    /// @param start node the traversal starts at
+    /// @param steps number of links the traversal will follow
+    prefetchcursor(Node *start, size_t steps) : lead(start), remaining(steps)
+    {
+        for (uint8_t i = 0; i < Distance; ++i)
+        {
+            advance();
+        }
+    }
+
+    /// @brief call once for every link the traversal follows
+    void advance()
+    {
+        if (remaining > 0)
+        {
+            lead = lead->*Link;
+            --remaining;
+            const char *bytes = reinterpret_cast<const char *>(lead);
+            __builtin_prefetch(bytes);
+            __builtin_prefetch(bytes + sizeof(nodeslot<Node, NodeStorageType>) - 1);
+        }
+    }
+
+private:
+    Node *lead;       ///< node Distance links ahead of the traversal
+    size_t remaining; ///< links the lead may still follow
+};
+
+/// @brief prefetching disabled: no state and no work
+template <typename Node, typename NodeStorageType, Node *Node::*Link>
+class prefetchcursor<Node, NodeStorageType, Link, 0>
+{
+public:
+    prefetchcursor(Node *, size_t) {}
+    void advance() {}
+};
+
+/// @brief node slots embedded in the owning object
+/// @details Slots are handed out in address order the first time, then reused
+/// from an intrusive free list threaded through each free node's n pointer.
+template <typename Node, typename NodeStorageType, uint8_t Count>
+class inlineslots
+{
+public:
+    inlineslots() : free_slots(nullptr), untouched(0U) {}
+    inlineslots(const inlineslots &) = delete;
+    inlineslots &operator=(const inlineslots &) = delete;
+
+    /// @brief takes a free inline slot
+    /// @return node of the slot, or null if every inline slot is in use
+    Node *take_inline()
+    {
+        if (free_slots != nullptr)
+        {
+            Node *node = free_slots;
+            free_slots = node->n;
+            node->n = nullptr;
+            return node;
+        }
+        if (untouched < Count)
+        {
+            return &(new (slot_bytes + sizeof(slot) * untouched++) slot())->node;
+        }
+        return nullptr;
+    }
+
+    /// @brief returns a slot to the inline free list
+    /// @param node node of the slot
+    /// @return false if the slot is not one of the inline slots
+    bool give_inline(Node *node)
+    {
+        if (!is_inline(node))
+        {
+            return false;
+        }
+        node->n = free_slots;
+        free_slots = node;
+        return true;
+    }
+
+    /// @brief counts the inline slots not holding a node
+    /// @return number of free inline slots
+    uint8_t inline_available() const
+    {
+        uint8_t available = Count - untouched;
+        for (const Node *node = free_slots; node != nullptr; node = node->n)
+        {
+            ++available;
+        }
+        return available;
+    }
+
+    /// @brief checks whether a node lives in the inline slots
+    /// @param node node to check
+    /// @return true if node is embedded in this object
+    bool is_inline(const Node *node) const
+    {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(node);
+        return bytes >= slot_bytes && bytes < slot_bytes + sizeof(slot_bytes);
+    }
+
+private:
+    typedef nodeslot<Node, NodeStorageType> slot;
+    Node *free_slots;  ///< previously used, now free, inline slots
+    uint8_t untouched; ///< index of the first never-used inline slot
+    alignas(slot) unsigned char slot_bytes[sizeof(slot) * Count]; ///< inline slot storage
+};
+
+/// @brief no inline slots: empty, so it costs nothing as a base class
+template <typename Node, typename NodeStorageType>
+class inlineslots<Node, NodeStorageType, 0>
+{
+public:
+    inlineslots() {}
+    inlineslots(const inlineslots &) = delete;
+    inlineslots &operator=(const inlineslots &) = delete;
+
+    Node *take_inline() { return nullptr; }
+    bool give_inline(Node *) { return false; }
+    uint8_t inline_available() const { return 0; }
+    bool is_inline(const Node *) const { return false; }
+};
+
+/// @brief sorts a singly linked list by node address
+/// @details bottom-up merge sort: O(n log n) time, O(1) space, no recursion
+/// @tparam Link member pointer to the next link
+/// @param list first item, or null
+/// @return first item of the sorted list
+template <typename Item, Item *Item::*Link>
+Item *sort_by_address(Item *list)
+{
+    if (list == nullptr)
+    {
+        return nullptr;
+    }
+    for (size_t width = 1U;; width *= 2U)
+    {
+        Item *left = list;
+        Item *tail = nullptr;
+        size_t merges = 0U;
+        list = nullptr;
+        while (left != nullptr)
+        {
+            ++merges;
+            Item *right = left;
+            size_t left_size = 0U;
+            while (left_size < width && right != nullptr)
+            {
+                ++left_size;
+                right = right->*Link;
+            }
+            size_t right_size = width;
+            while (left_size > 0U || (right_size > 0U && right != nullptr))
+            {
+                Item *item;
+                if (left_size > 0U && (right_size == 0U || right == nullptr || left < right))
+                {
+                    item = left;
+                    left = left->*Link;
+                    --left_size;
+                }
+                else
+                {
+                    item = right;
+                    right = right->*Link;
+                    --right_size;
+                }
+                if (tail != nullptr)
+                {
+                    tail->*Link = item;
+                }
+                else
+                {
+                    list = item;
+                }
+                tail = item;
+            }
+            left = right;
+        }
+        tail->*Link = nullptr;
+        if (merges <= 1U)
+        {
+            return list;
+        }
+    }
+}
+
+/// @brief heap slots carved from a chain of slabs
+/// @details Each slab is one allocation: a header followed by its slots. The
+/// first slab holds FirstSlab slots and each later one twice as many as the
+/// last, up to 64 times FirstSlab, so a growing list makes O(log n) allocator
+/// calls. Slots never return to the allocator one by one; release_empty()
+/// frees whole slabs once none of their slots is in use.
+template <typename Node, typename NodeStorageType, uint16_t FirstSlab>
+class slabchain
+{
+public:
+    slabchain() : slabs(nullptr), next_slots(FirstSlab), slab_slots_total(0U) {}
+    slabchain(const slabchain &) = delete;
+    slabchain &operator=(const slabchain &) = delete;
+
+    ~slabchain()
+    {
+        while (slabs != nullptr)
+        {
+            slabheader *next = slabs->next;
+            delete[] reinterpret_cast<unsigned char *>(slabs);
+            slabs = next;
+        }
+    }
+
+    /// @brief allocates the next slab and pushes its slots onto a free list
+    /// @param free_list list threaded through n; the slab's first slot ends up in front
+    /// @param limit most slots all slabs together may hold
+    /// @return number of slots added, 0 on allocation failure or at the limit
+    size_t grow_slab(Node *&free_list, size_t limit)
+    {
+        size_t slots = next_slots;
+        if (slots > limit - slab_slots_total)
+        {
+            slots = limit - slab_slots_total;
+        }
+        if (slots == 0U)
+        {
+            return 0U;
+        }
+        unsigned char *bytes = new_slab(slots);
+        if (bytes == nullptr && slots > FirstSlab)
+        {
+            slots = FirstSlab; // the heap is short; settle for a first-size slab
+            next_slots = FirstSlab;
+            bytes = new_slab(slots);
+        }
+        if (bytes == nullptr)
+        {
+            return 0U;
+        }
+        if (next_slots < 64U * FirstSlab)
+        {
+            next_slots *= 2U;
+        }
+        for (size_t i = slots; i > 0; --i)
+        {
+            Node *node = slot_node(bytes, i - 1U);
+            node->n = free_list;
+            free_list = node;
+        }
+        return slots;
+    }
+
+    /// @brief allocates one slab of exactly slots slots and keeps it off any free list
+    /// @param slots slots wanted, at least 1
+    /// @return node of the first slot, or null on allocation failure; the
+    /// others follow in address order, see next_slot()
+    Node *take_slab(size_t slots)
+    {
+        unsigned char *bytes = new_slab(slots);
+        return bytes != nullptr ? slot_node(bytes, 0U) : nullptr;
+    }
+
+    /// @brief gets the slot after node in the same slab
+    static Node *next_slot(Node *node)
+    {
+        return &(reinterpret_cast<slot *>(node) + 1)->node;
+    }
+
+    /// @brief frees every slab whose slots are all on free_list
+    /// @details sorts the slabs and the free list by address, so it runs in
+    /// O(n log n) without allocating, and later inserts take free slots in
+    /// address order
+    /// @param free_list list threaded through n; the freed slots are unlinked from it
+    /// @return number of slots freed
+    size_t release_empty(Node *&free_list)
+    {
+        slabs = sort_by_address<slabheader, &slabheader::next>(slabs);
+        free_list = sort_by_address<Node, &Node::n>(free_list);
+        slabheader *slab = slabs;
+        for (slabheader *each = slabs; each != nullptr; each = each->next)
+        {
+            each->free_slots = 0U;
+        }
+        for (Node *node = free_list; node != nullptr; node = node->n)
+        {
+            while (!holds(slab, node))
+            {
+                slab = slab->next;
+            }
+            ++slab->free_slots;
+        }
+        size_t released = 0U;
+        slab = slabs;
+        Node **link = &free_list;
+        while (*link != nullptr)
+        {
+            while (!holds(slab, *link))
+            {
+                slab = slab->next;
+            }
+            if (slab->free_slots == slab->slots)
+            {
+                *link = (*link)->n;
+                ++released;
+            }
+            else
+            {
+                link = &(*link)->n;
+            }
+        }
+        next_slots = FirstSlab; // growth restarts from the largest slab kept
+        slabheader **at = &slabs;
+        while (*at != nullptr)
+        {
+            slab = *at;
+            if (slab->free_slots == slab->slots)
+            {
+                *at = slab->next;
+                slab_slots_total -= slab->slots;
+                delete[] reinterpret_cast<unsigned char *>(slab);
+                continue;
+            }
+            size_t doubled = slab->slots < 32U * FirstSlab ? slab->slots * 2U : 64U * FirstSlab;
+            if (doubled > next_slots)
+            {
+                next_slots = doubled;
+            }
+            at = &slab->next;
+        }
+        return released;
+    }
+
+    /// @brief frees every slab except one taken from take_slab()
+    /// @param first node returned by take_slab()
+    void release_other_slabs(Node *first)
+    {
+        slabheader *kept = reinterpret_cast<slabheader *>(reinterpret_cast<unsigned char *>(first) - header_bytes);
+        while (slabs != nullptr)
+        {
+            slabheader *next = slabs->next;
+            if (slabs != kept)
+            {
+                delete[] reinterpret_cast<unsigned char *>(slabs);
+            }
+            slabs = next;
+        }
+        kept->next = nullptr;
+        slabs = kept;
+        slab_slots_total = kept->slots;
+        next_slots = kept->slots < 32U * FirstSlab ? kept->slots * 2U : 64U * FirstSlab;
+        if (next_slots < FirstSlab)
+        {
+            next_slots = FirstSlab;
+        }
+    }
+
+    /// @brief exchanges slabs with another chain
+    void swap_slabs(slabchain &other)
+    {
+        slabheader *chain = slabs;
+        slabs = other.slabs;
+        other.slabs = chain;
+        size_t count = next_slots;
+        next_slots = other.next_slots;
+        other.next_slots = count;
+        count = slab_slots_total;
+        slab_slots_total = other.slab_slots_total;
+        other.slab_slots_total = count;
+    }
+
+    /// @brief bytes spent on slab headers and allocator bookkeeping, see listmemory
+    size_t slab_overhead() const
+    {
+        size_t bytes = 0U;
+        for (const slabheader *slab = slabs; slab != nullptr; slab = slab->next)
+        {
+            bytes += header_bytes + heap_overhead(slab_bytes(slab->slots));
+        }
+        return bytes;
+    }
+
+private:
+    typedef nodeslot<Node, NodeStorageType> slot;
+
+    /// @brief start of every slab, followed by its slots
+    struct slabheader
+    {
+        slabheader *next;  ///< next slab in the chain
+        size_t slots;      ///< slots in this slab
+        size_t free_slots; ///< scratch count for release_empty()
+    };
+
+    /// @brief header size rounded up so the first slot is aligned
+    static const size_t header_bytes = (sizeof(slabheader) + alignof(slot) - 1U) / alignof(slot) * alignof(slot);
+
+    /// @brief size of the allocation behind a slab of slots slots
+    static size_t slab_bytes(size_t slots)
+    {
+        return header_bytes + sizeof(slot) * slots;
+    }
+
+    /// @brief allocates a slab, constructs its slots and links it into the chain
+    /// @return the slab's bytes, or null on allocation failure
+    unsigned char *new_slab(size_t slots)
+    {
+        unsigned char *bytes = new unsigned char[slab_bytes(slots)];
+        if (bytes == nullptr)
+        {
+            return nullptr;
+        }
+        slabheader *slab = reinterpret_cast<slabheader *>(bytes);
+        slab->next = slabs;
+        slab->slots = slots;
+        slabs = slab;
+        slab_slots_total += slots;
+        for (size_t i = 0; i < slots; ++i)
+        {
+            new (bytes + header_bytes + sizeof(slot) * i) slot();
+        }
+        return bytes;
+    }
+
+    /// @brief node of slot index of a slab
+    static Node *slot_node(unsigned char *bytes, size_t index)
+    {
+        return &reinterpret_cast<slot *>(bytes + header_bytes + sizeof(slot) * index)->node;
+    }
+
+    /// @brief checks whether a slot was carved from slab
+    static bool holds(const slabheader *slab, const Node *node)
+    {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char *>(node);
+        const unsigned char *base = reinterpret_cast<const unsigned char *>(slab);
+        return bytes >= base + header_bytes && bytes < base + slab_bytes(slab->slots);
+    }
+
+    slabheader *slabs;       ///< every slab, in no particular order
+    size_t next_slots;       ///< size of the next slab
+    size_t slab_slots_total; ///< slots across every slab
+};
+
+/// @brief no slabs: heap slots are allocated one by one, and the chain costs nothing as a base class
+template <typename Node, typename NodeStorageType>
+class slabchain<Node, NodeStorageType, 0>
+{
+public:
+    slabchain() {}
+    slabchain(const slabchain &) = delete;
+    slabchain &operator=(const slabchain &) = delete;
+
+    size_t grow_slab(Node *&, size_t) { return 0U; }
+    Node *take_slab(size_t) { return nullptr; }
+    void release_other_slabs(Node *) {}
+    static Node *next_slot(Node *node) { return node; }
+    size_t release_empty(Node *&) { return 0U; }
+    void swap_slabs(slabchain &) {}
+    size_t slab_overhead() const { return 0U; }
+};
+
+/// @brief free heap slots kept for reuse: the spare list behind reserve() and slabs
+/// @details Heap slots preallocated by reserve_slots() wait on a spare list
+/// threaded through n, and released slots go back to it while the reserved
+/// capacity is not yet met. With Traits::slab_slots > 0 heap slots come from a
+/// slabchain instead, and the spare list holds every free slab slot. Lists
+/// with neither Traits::reservable nor slabs get the empty specialisation
+/// below, so they pay no bytes for it.
+template <typename Node, typename NodeStorageType, typename Traits,
+          bool Spares = (Traits::reservable || Traits::slab_slots > 0)>
+class spareslots : private slabchain<Node, NodeStorageType, Traits::slab_slots>
+{
+public:
+    typedef typename Traits::size_type size_type; ///< node count type
+
+    spareslots() : spare_slots(nullptr), spare_count(0U), reserved(0U) {}
+    spareslots(const spareslots &) = delete;
+    spareslots &operator=(const spareslots &) = delete;
+
+    ~spareslots()
+    {
+        free_spares();
+    }
+
+protected:
+    /// @brief takes a spare slot, growing the slab chain first if it has none
+    /// @return node of the slot, or null if there is none and no slab could be added
+    Node *take_spare()
+    {
+        if (spare_slots == nullptr && slabbed)
+        {
+            spare_count += (size_type)this->grow_slab(spare_slots, sizelimit<size_type>::max);
+        }
+        if (spare_slots == nullptr)
+        {
+            return nullptr;
+        }
+        Node *node = spare_slots;
+        spare_slots = node->n;
+        node->n = nullptr;
+        --spare_count;
+        return node;
+    }
+
+    /// @brief keeps a released heap slot as a spare if it is a slab slot or
+    /// the reservation is not yet met
+    /// @param node node of the slot
+    /// @param live nodes still in the list once this one is gone
+    /// @return false if the caller must delete the slot
+    bool keep_spare(Node *node, size_type live)
+    {
+        if (slabbed || live + spare_count < reserved)
+        {
+            node->n = spare_slots;
+            spare_slots = node;
+            ++spare_count;
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief preallocates heap slots until live nodes plus free slots reach capacity
+    /// @param live nodes currently in the list
+    /// @param free_inline free inline slots
+    /// @param capacity slots wanted in total
+    /// @return false if an allocation failed
+    bool reserve_slots(size_type live, size_type free_inline, size_type capacity)
+    {
+        if (capacity > reserved)
+        {
+            reserved = capacity;
+        }
+        size_type have = live + spare_count + free_inline;
+        while (have < capacity)
+        {
+            if (slabbed)
+            {
+                size_type added = (size_type)this->grow_slab(spare_slots, sizelimit<size_type>::max);
+                if (added == 0U)
+                {
+                    return false;
+                }
+                spare_count += added;
+                have += added;
+                continue;
+            }
+            slot *heap_slot = new slot();
+            if (heap_slot == nullptr)
+            {
+                return false;
+            }
+            heap_slot->node.n = spare_slots;
+            spare_slots = &heap_slot->node;
+            ++spare_count;
+            ++have;
+        }
+        return true;
+    }
+
+    /// @brief frees every spare heap slot (every empty slab) and drops the reservation
+    void shrink_slots()
+    {
+        reserved = 0U;
+        if (slabbed)
+        {
+            spare_count -= (size_type)this->release_empty(spare_slots);
+            return;
+        }
+        free_spares();
+    }
+
+    /// @brief one slab holding given heap slots side by side, for compaction
+    using slabchain<Node, NodeStorageType, Traits::slab_slots>::take_slab;
+
+    /// @brief the slot after a slot taken from take_slab()
+    using slabchain<Node, NodeStorageType, Traits::slab_slots>::next_slot;
+
+    /// @brief bytes spent on slab headers and allocator bookkeeping
+    using slabchain<Node, NodeStorageType, Traits::slab_slots>::slab_overhead;
+
+    /// @brief ends a compaction: frees every slab but the one holding the
+    /// relocated nodes and drops the spare slots and the reservation
+    /// @param first node returned by take_slab()
+    void finish_compaction(Node *first)
+    {
+        this->release_other_slabs(first);
+        spare_slots = nullptr;
+        spare_count = 0U;
+        reserved = 0U;
+    }
+
+    /// @brief exchanges spare slots and slabs with another pool
+    /// @details nodes carved from slabs belong to the pool that owns the slab,
+    /// so a list taking over another's nodes must take over its slabs too
+    /// @param other pool to exchange with
+    void swap_slabs(spareslots &other)
+    {
+        slabchain<Node, NodeStorageType, Traits::slab_slots>::swap_slabs(other);
+        Node *node = spare_slots;
+        spare_slots = other.spare_slots;
+        other.spare_slots = node;
+        size_type count = spare_count;
+        spare_count = other.spare_count;
+        other.spare_count = count;
+    }
+
+    /// @brief counts the spare heap slots
+    size_type spare_total() const
+    {
+        return spare_count;
+    }
+
+private:
+    typedef nodeslot<Node, NodeStorageType> slot;
+
+    /// @brief heap slots come from slabs
+    static const bool slabbed = Traits::slab_slots > 0;
+
+    /// @brief deletes the spare heap slots; slab slots go with their slabs
+    void free_spares()
+    {
+        while (!slabbed && spare_slots != nullptr)
+        {
+            Node *node = spare_slots;
+            spare_slots = node->n;
+            delete reinterpret_cast<slot *>(node);
+        }
+        spare_slots = nullptr;
+        spare_count = 0U;
+    }
+
+    Node *spare_slots;     ///< preallocated heap slots not holding a node
+    size_type spare_count; ///< number of spare heap slots
+    size_type reserved;    ///< capacity kept by keep_spare()
+};
+
+/// @brief no spare slots: released heap slots go straight back to the
+/// allocator, and the pool costs nothing as a base class
+template <typename Node, typename NodeStorageType, typename Traits>
+class spareslots<Node, NodeStorageType, Traits, false>
+{
+public:
+    typedef typename Traits::size_type size_type; ///< node count type
+
+    spareslots() {}
+    spareslots(const spareslots &) = delete;
+    spareslots &operator=(const spareslots &) = delete;
+
+protected:
+    Node *take_spare() { return nullptr; }
+    bool keep_spare(Node *, size_type) { return false; }
+    void shrink_slots() {}
+    void swap_slabs(spareslots &) {}
+    size_type spare_total() const { return 0U; }
+    size_t slab_overhead() const { return 0U; }
+};
+
+/// @brief node + storage slot allocator used by the list templates
+/// @details Node and payload share one allocation. The first Traits::inline_nodes
+/// slots are embedded in the pool, further slots come from the spare slots
+/// (see spareslots) and then the heap.
+template <typename Node, typename NodeStorageType, typename Traits>
+class nodepool : protected inlineslots<Node, NodeStorageType, Traits::inline_nodes>,
+                 protected spareslots<Node, NodeStorageType, Traits>
+{
+public:
+    typedef typename Traits::size_type size_type; ///< node count type
+
+protected:
+    /// @brief gets an unconstructed slot: inline first, then spare, then heap
+    /// @return node whose sp points at raw payload storage, or null on allocation failure
+    Node *acquire_slot()
+    {
+        Node *node = this->take_inline();
+        if (node == nullptr)
+        {
+            node = this->take_spare();
+        }
+        if (node == nullptr && !slabbed)
+        {
+            slot *heap_slot = new slot();
+            if (heap_slot == nullptr)
+            {
+                return nullptr;
+            }
+            node = &heap_slot->node;
+        }
+        return node;
+    }
+
+    /// @brief returns a slot whose payload has already been destroyed
+    /// @param node node of the slot
+    /// @param live nodes still in the list once this one is gone
+    void release_slot(Node *node, size_type live)
+    {
+        if (this->give_inline(node) || this->keep_spare(node, live))
+        {
+            return;
+        }
+        delete reinterpret_cast<slot *>(node);
+    }
+
+    /// @brief preallocates heap slots until live nodes plus free slots reach
+    /// capacity; needs Traits::reservable or slabs
+    /// @param live nodes currently in the list
+    /// @param capacity slots wanted in total
+    /// @return false if an allocation failed
+    bool reserve_slots(size_type live, size_type capacity)
+    {
+        return spareslots<Node, NodeStorageType, Traits>::reserve_slots(live, this->inline_available(), capacity);
+    }
+
+    /// @brief counts the live nodes outside the inline slots
+    /// @param live nodes in the list
+    size_type heap_nodes(size_type live) const
+    {
+        return live - (Traits::inline_nodes - this->inline_available());
+    }
+
+    /// @brief accounts for the memory behind a list
+    /// @param live nodes in the list
+    /// @param object_bytes sizeof the list object
+    /// @return byte counts, see listmemory
+    listmemory slot_usage(size_type live, size_t object_bytes) const
+    {
+        size_t free_inline = this->inline_available();
+        size_t spare = this->spare_total();
+        size_t heap_slots = (size_t)live - (Traits::inline_nodes - free_inline) + spare;
+        listmemory usage;
+        usage.object = object_bytes - sizeof(slot) * Traits::inline_nodes;
+        usage.nodes = (size_t)live * (sizeof(slot) - sizeof(NodeStorageType));
+        usage.payloads = (size_t)live * sizeof(NodeStorageType);
+        usage.unused = (spare + free_inline) * sizeof(slot);
+        usage.overhead = slabbed ? this->slab_overhead() : heap_slots * heap_overhead(sizeof(slot));
+        return usage;
+    }
+
+    /// @brief counts the slots available without a heap allocation
+    /// @return spare heap slots plus free inline slots
+    size_type available_slots() const
+    {
+        return this->spare_total() + this->inline_available();
+    }
+
+private:
+    typedef nodeslot<Node, NodeStorageType> slot;
+
+    /// @brief heap slots come from slabs
+    static const bool slabbed = Traits::slab_slots > 0;
+};
+
+#endif // NODE_POOL_H
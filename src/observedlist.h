@@ -0,0 +1,365 @@
+#ifndef OBSERVED_LIST_H
+#define OBSERVED_LIST_H
+
+#include <Arduino.h>
+
+/// @brief where a payload entered or left an observedlist
+enum listedge : uint8_t
+{
+    EDGE_FRONT,  ///< at the head
+    EDGE_BACK,   ///< at the tail
+    EDGE_INSIDE  ///< anywhere else, or not known to be an end
+};
+
+/// @brief the list an observedlist wraps, seen through any nested observedlists
+template <typename List, typename Plain = void>
+struct observedplain
+{
+    typedef List type;
+};
+
+template <typename List>
+struct observedplain<List, typename List::plain_list_check>
+{
+    typedef typename List::plain_list type;
+};
+
+/// @brief list wrapper that reports every payload added to or removed from the list
+/// @details Derives from List and shadows each operation that changes which
+/// payloads the list holds, calling on the Observer member:
+/// - `added(payload, edge)` after a payload is linked in,
+/// - `removed(payload, edge)` before a payload is deleted or spliced out,
+/// - `cleared()` when the list is emptied at once,
+/// - `reordered()` after reverse() or partition() moved payloads around
+///   without adding or removing any.
+///
+/// deleteFromPosition() and removeAtBeginning() look the payload up before
+/// deleting it, which costs one more positional lookup. insertAtPosition(),
+/// removeIf(), unique() and deleteRange() not starting at the head report
+/// EDGE_INSIDE. Payloads changed in place are not seen; rebuild() reports the
+/// whole list again, as swap() with and assignment from a plain List do.
+/// Wrappers nest: List may itself be an observedlist.
+/// @tparam List singlylist, circulardoublylist or any basic_ variant
+/// @tparam Observer default-constructible, copyable and movable; default-constructed means empty
+template <typename List, typename Observer>
+class observedlist : public List
+{
+public:
+    typedef typename List::size_type size_type;           ///< node count and position type
+    typedef typename observedplain<List>::type plain_list; ///< innermost list type, not observed
+    typedef void plain_list_check;                         ///< marks a type with plain_list
+
+    observedlist() {}
+
+    observedlist(const observedlist &other) = default;
+
+    /// @brief takes other's nodes and observer state; other is left empty
+    observedlist(observedlist &&other) noexcept : List(static_cast<List &&>(other)), observer(static_cast<Observer &&>(other.observer))
+    {
+        other.observer = Observer();
+    }
+
+    observedlist &operator=(const observedlist &other) = default;
+
+    /// @brief takes other's nodes and observer state; other is left empty
+    observedlist &operator=(observedlist &&other) noexcept
+    {
+        if (this != &other)
+        {
+            List::operator=(static_cast<List &&>(other));
+            observer = static_cast<Observer &&>(other.observer);
+            other.observer = Observer();
+        }
+        return *this;
+    }
+
+    /// @brief replaces the contents with a copy of a plain list and reports them
+    observedlist &operator=(const plain_list &other)
+    {
+        List::operator=(other);
+        rebuild();
+        return *this;
+    }
+
+    /// @brief takes a plain list's nodes and reports them; other is left empty
+    observedlist &operator=(plain_list &&other)
+    {
+        List::operator=(static_cast<plain_list &&>(other));
+        rebuild();
+        return *this;
+    }
+
+    /// @brief exchanges the contents and the observer states of two lists
+    void swap(observedlist &other) noexcept
+    {
+        List::swap(other);
+        Observer held(static_cast<Observer &&>(observer));
+        observer = static_cast<Observer &&>(other.observer);
+        other.observer = static_cast<Observer &&>(held);
+    }
+
+    /// @brief exchanges the contents with a plain list and reports the new contents
+    void swap(plain_list &other)
+    {
+        List::swap(other);
+        rebuild();
+    }
+
+    template <typename... Args>
+    auto insertAtBeginning(Args... args) -> decltype(List::insertAtBeginning(args...))
+    {
+        return report_added(List::insertAtBeginning(args...), EDGE_FRONT);
+    }
+
+    template <typename... Args>
+    auto insertAtEnd(Args... args) -> decltype(List::insertAtEnd(args...))
+    {
+        return report_added(List::insertAtEnd(args...), EDGE_BACK);
+    }
+
+    /// @brief reports the overwritten head as removed, then the new payload as added
+    template <typename L = List, typename... Args>
+    auto insertAtEndBounded(size_type bound, Args... args) -> decltype(static_cast<L *>(nullptr)->insertAtEndBounded(bound, args...))
+    {
+        if (bound >= 1 && List::size() >= bound)
+        {
+            observer.removed(*List::begin(), EDGE_FRONT);
+        }
+        return report_added(List::insertAtEndBounded(bound, args...), EDGE_BACK);
+    }
+
+    template <typename... Args>
+    auto insertAtPosition(size_type position, Args... args) -> decltype(List::insertAtPosition(position, args...))
+    {
+        listedge edge = position == 1 ? EDGE_FRONT : (position - 1 == List::size() ? EDGE_BACK : EDGE_INSIDE);
+        return report_added(List::insertAtPosition(position, args...), edge);
+    }
+
+    template <typename T>
+    auto insertCopyAtEnd(const T &value) -> decltype(List::insertCopyAtEnd(value))
+    {
+        return report_added(List::insertCopyAtEnd(value), EDGE_BACK);
+    }
+
+    template <typename T>
+    size_type fromArray(const T *values, size_type count)
+    {
+        size_type appended = List::fromArray(values, count);
+        for (size_type i = 0; i < appended; ++i)
+        {
+            observer.added(values[i], EDGE_BACK);
+        }
+        return appended;
+    }
+
+    bool deleteFromPosition(size_type position)
+    {
+        auto payload = List::getStoragePtr(position);
+        if (payload == nullptr)
+        {
+            return false;
+        }
+        observer.removed(*payload, position == 1 ? EDGE_FRONT : (position == List::size() ? EDGE_BACK : EDGE_INSIDE));
+        return List::deleteFromPosition(position);
+    }
+
+    template <typename L = List>
+    auto removeAtBeginning() -> decltype(static_cast<L *>(nullptr)->removeAtBeginning())
+    {
+        auto payload = List::getStoragePtr(1);
+        if (payload != nullptr)
+        {
+            observer.removed(*payload, EDGE_FRONT);
+        }
+        return List::removeAtBeginning();
+    }
+
+    bool deleteRange(size_type first, size_type last)
+    {
+        if (first < 1 || last < first || last > List::size())
+        {
+            return false;
+        }
+        auto it = List::begin();
+        for (size_type position = 1; position < first; ++position)
+        {
+            ++it;
+        }
+        for (size_type k = last - first + 1; k > 0; --k, ++it) // counts down: last may be size_type's maximum
+        {
+            observer.removed(*it, first == 1 ? EDGE_FRONT : EDGE_INSIDE);
+        }
+        return List::deleteRange(first, last);
+    }
+
+    template <typename Predicate>
+    size_type removeIf(Predicate pred)
+    {
+        return List::removeIf(reportif<Predicate>(observer, pred));
+    }
+
+    template <typename Equal>
+    size_type unique(Equal eq)
+    {
+        return List::unique(reportduplicate<Equal>(observer, eq));
+    }
+
+    void reverse()
+    {
+        List::reverse();
+        observer.reordered();
+    }
+
+    template <typename Predicate>
+    auto partition(Predicate pred) -> decltype(List::partition(pred))
+    {
+        auto back = List::partition(pred);
+        observer.reordered();
+        return back;
+    }
+
+    template <typename Node, typename L = List>
+    auto deleteNode(Node *node) -> decltype(static_cast<L *>(nullptr)->deleteNode(node))
+    {
+        if (node != nullptr)
+        {
+            observer.removed(*node->sp, node == List::begin().node() ? EDGE_FRONT : EDGE_INSIDE);
+        }
+        return List::deleteNode(node);
+    }
+
+    /// @brief moves a node from another observedlist, reporting to both observers
+    template <typename Node, typename L = List>
+    auto spliceAtEnd(Node *node, observedlist &from) -> decltype(static_cast<L *>(nullptr)->spliceAtEnd(node, from))
+    {
+        listedge edge = node == from.begin().node() ? EDGE_FRONT : EDGE_INSIDE;
+        if (!List::spliceAtEnd(node, from))
+        {
+            return false;
+        }
+        from.observer.removed(*node->sp, edge);
+        observer.added(*node->sp, EDGE_BACK);
+        return true;
+    }
+
+    /// @brief moves a node from a plain list
+    template <typename Node, typename L = List>
+    auto spliceAtEnd(Node *node, plain_list &from) -> decltype(static_cast<L *>(nullptr)->spliceAtEnd(node, from))
+    {
+        if (!List::spliceAtEnd(node, from))
+        {
+            return false;
+        }
+        observer.added(*node->sp, EDGE_BACK);
+        return true;
+    }
+
+    /// @brief moves every node of another observedlist to the end, reporting to both observers
+    template <typename L = List>
+    auto spliceAllAtEnd(observedlist &from) -> decltype(static_cast<L *>(nullptr)->spliceAllAtEnd(from))
+    {
+        if (!report_spliced(from))
+        {
+            return false;
+        }
+        from.observer.cleared();
+        return true;
+    }
+
+    /// @brief moves every node of a plain list to the end
+    template <typename L = List>
+    auto spliceAllAtEnd(plain_list &from) -> decltype(static_cast<L *>(nullptr)->spliceAllAtEnd(from))
+    {
+        return report_spliced(from);
+    }
+
+    void clear()
+    {
+        List::clear();
+        observer.cleared();
+    }
+
+    /// @brief reports the whole list to a cleared observer again, head to tail
+    /// @details needed after payloads were changed in place
+    void rebuild()
+    {
+        observer.cleared();
+        for (auto it = List::begin(); it != List::end(); ++it)
+        {
+            observer.added(*it, EDGE_BACK);
+        }
+    }
+
+protected:
+    Observer observer; ///< told about every payload added or removed
+
+private:
+    template <typename Predicate>
+    struct reportif
+    {
+        reportif(Observer &target, Predicate &predicate) : told(target), pred(predicate) {}
+        template <typename T>
+        bool operator()(T &payload)
+        {
+            if (!pred(payload))
+            {
+                return false;
+            }
+            told.removed(payload, EDGE_INSIDE);
+            return true;
+        }
+        Observer &told;  ///< observer of the list
+        Predicate &pred; ///< caller's predicate
+    };
+
+    template <typename Equal>
+    struct reportduplicate
+    {
+        reportduplicate(Observer &target, Equal &equal) : told(target), eq(equal) {}
+        template <typename T>
+        bool operator()(T &kept, T &duplicate)
+        {
+            if (!eq(kept, duplicate))
+            {
+                return false;
+            }
+            told.removed(duplicate, EDGE_INSIDE);
+            return true;
+        }
+        Observer &told; ///< observer of the list
+        Equal &eq;      ///< caller's equality
+    };
+
+    template <typename Node>
+    Node *report_added(Node *node, listedge edge)
+    {
+        if (node != nullptr)
+        {
+            observer.added(*node->sp, edge);
+        }
+        return node;
+    }
+
+    /// @brief splices every node of from to the end and reports them
+    template <typename From>
+    bool report_spliced(From &from)
+    {
+        size_type before = List::size();
+        if (!List::spliceAllAtEnd(from))
+        {
+            return false;
+        }
+        auto it = List::begin();
+        for (size_type position = 0; position < before; ++position)
+        {
+            ++it;
+        }
+        for (; it != List::end(); ++it)
+        {
+            observer.added(*it, EDGE_BACK);
+        }
+        return true;
+    }
+};
+
+#endif // OBSERVED_LIST_H
@@ -0,0 +1,216 @@
+#ifndef PERSISTENT_LIST_H
+#define PERSISTENT_LIST_H
+
+#include <Arduino.h>
+#include "listatomic.h"
+
+/// @brief immutable, reference-counted node of a persistentlist
+template <typename NodeStorageType>
+struct persistentnode
+{
+    /// @brief builds a node owning one reference to next
+    /// @param next_node rest of the list, or null
+    /// @param args Arguments to construct the storage
+    template <typename... StorageArgs>
+    persistentnode(persistentnode *next_node, StorageArgs... args) : v{args...}, n(next_node), refs(1U) {}
+    const NodeStorageType v;  ///< payload, never modified after construction
+    persistentnode *const n;  ///< next node or null, shared by every version that reaches it
+    listatomic<size_t> refs;  ///< versions and nodes pointing at this node
+};
+
+/// @brief persistent singly linked list: every version stays valid and unchanged
+/// @details A persistentlist object is one version, a head pointer plus a length.
+/// pushFront links a new node in front of the current head, popFront steps past
+/// it, and snapshot() copies the head pointer, so all three are O(1) and
+/// versions share their tails. Nodes are freed when the last version reaching
+/// them lets go. Reference counts are atomic, so a snapshot can be handed to
+/// another thread (or an interrupt handler on AVR) and read there while the
+/// writer keeps working on its own version; nothing ever blocks. A single
+/// persistentlist object must not be used from two threads at once.
+template <typename NodeStorageType, typename... StorageArgs>
+class persistentlist
+{
+public:
+    /// @brief immutable list node with the payload in v and next in n
+    typedef persistentnode<NodeStorageType> pnode;
+
+    /// @brief forward iterator over the payloads of one version
+    class iterator
+    {
+    public:
+        explicit iterator(const pnode *node) : current(node) {}
+        const NodeStorageType &operator*() const { return current->v; }
+        const NodeStorageType *operator->() const { return &current->v; }
+        iterator &operator++()
+        {
+            current = current->n;
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return current == other.current; }
+        bool operator!=(const iterator &other) const { return current != other.current; }
+
+    private:
+        const pnode *current; ///< node the iterator is at
+    };
+
+    /// @brief empty list
+    persistentlist() : head(nullptr), list_nodes(0U) {}
+
+    /// @brief shares other's nodes, see snapshot()
+    persistentlist(const persistentlist &other) : head(other.head), list_nodes(other.list_nodes)
+    {
+        retain(head);
+    }
+
+    /// @brief takes over other's version and leaves other empty
+    persistentlist(persistentlist &&other) noexcept : head(other.head), list_nodes(other.list_nodes)
+    {
+        other.head = nullptr;
+        other.list_nodes = 0U;
+    }
+
+    ~persistentlist()
+    {
+        release(head);
+    }
+
+    persistentlist &operator=(const persistentlist &other)
+    {
+        retain(other.head); // before release, in case both share nodes
+        release(head);
+        head = other.head;
+        list_nodes = other.list_nodes;
+        return *this;
+    }
+
+    persistentlist &operator=(persistentlist &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release(head);
+            head = other.head;
+            list_nodes = other.list_nodes;
+            other.head = nullptr;
+            other.list_nodes = 0U;
+        }
+        return *this;
+    }
+
+    /// @brief gets an O(1) copy of this version that later changes cannot affect
+    /// @return list sharing this version's nodes
+    persistentlist snapshot() const
+    {
+        return *this;
+    }
+
+    /// @brief links a new node in front of this version
+    /// @param args Arguments to construct the storage
+    /// @return false on allocation failure
+    bool pushFront(StorageArgs... args)
+    {
+        pnode *node = new pnode(head, args...); // takes over this version's reference to head
+        if (node == nullptr)
+        {
+            return false;
+        }
+        head = node;
+        list_nodes++;
+        return true;
+    }
+
+    /// @brief steps this version past its first node
+    /// @details the node is freed only if no other version still reaches it
+    /// @return false if the list is empty
+    bool popFront()
+    {
+        if (head == nullptr)
+        {
+            return false;
+        }
+        pnode *old_head = head;
+        head = old_head->n;
+        retain(head);
+        release(old_head);
+        list_nodes--;
+        return true;
+    }
+
+    /// @brief drops this version's nodes, leaving it empty
+    void clear()
+    {
+        release(head);
+        head = nullptr;
+        list_nodes = 0U;
+    }
+
+    /// @brief gets the first payload
+    /// @return pointer to the first payload, or null if empty
+    const NodeStorageType *front() const
+    {
+        return head ? &head->v : nullptr;
+    }
+
+    /// @brief gets the payload at position, walking from the head
+    /// @param position 1-... position in the list
+    /// @return pointer to storage at position, or null if out of range
+    const NodeStorageType *getStoragePtr(size_t position) const
+    {
+        if (position < 1 || position > list_nodes)
+        {
+            return nullptr; // position out of range
+        }
+        const pnode *current = head;
+        for (size_t i = 1; i < position; ++i)
+        {
+            current = current->n;
+        }
+        return &current->v;
+    }
+
+    /// @brief gets the number of list members
+    /// @return node count
+    size_t size() const
+    {
+        return list_nodes;
+    }
+
+    /// @brief checks whether two versions share their first node
+    /// @return true if other is this version or an unchanged snapshot of it
+    bool sharesWith(const persistentlist &other) const
+    {
+        return head == other.head;
+    }
+
+    /// @brief iterator at the head, for range-based for loops
+    iterator begin() const { return iterator(head); }
+
+    /// @brief iterator past the tail
+    iterator end() const { return iterator(nullptr); }
+
+private:
+    /// @brief adds a reference to node
+    static void retain(pnode *node)
+    {
+        if (node != nullptr)
+        {
+            node->refs.fetchAdd(1U);
+        }
+    }
+
+    /// @brief drops a reference to node, freeing every node no longer reachable
+    /// @details iterative, so dropping a long list never recurses
+    static void release(pnode *node)
+    {
+        while (node != nullptr && node->refs.subFetch(1U) == 0U)
+        {
+            pnode *next = node->n;
+            delete node;
+            node = next;
+        }
+    }
+
+    pnode *head;       ///< first node of this version
+    size_t list_nodes; ///< number of nodes in this version
+};
+
+#endif // PERSISTENT_LIST_H
@@ -0,0 +1,383 @@
+#ifndef RCU_LIST_H
+#define RCU_LIST_H
+
+#include <Arduino.h>
+#include "listatomic.h"
+
+/// @brief node of an rculist
+template <typename NodeStorageType>
+struct rculistnode
+{
+    template <typename... StorageArgs>
+    rculistnode(StorageArgs... args) : v{args...}, n(nullptr), p(nullptr), retired(nullptr), retired_epoch(0U) {}
+    NodeStorageType v;             ///< payload
+    listatomic<rculistnode *> n;   ///< next node, published with release stores, read with acquire loads
+    rculistnode *p;                ///< previous node, writer only
+    rculistnode *retired;          ///< next node awaiting reclamation, writer only
+    uint32_t retired_epoch;        ///< epoch in which the node was unlinked
+};
+
+/// @brief doubly linked list for many concurrent readers and one writer
+/// @details Readers follow the n links only, with acquire loads: they take no
+/// lock and perform no read-modify-write. A reader announces the epoch it
+/// entered in its own padded slot, so readers never share a written cache
+/// line. The writer links and unlinks with release stores, so a reader sees
+/// either the old or the new list, never a partial node. Unlinked nodes are
+/// retired rather than freed and reclaimed once every reader that could
+/// still hold them has left its read section (epoch-based reclamation).
+///
+/// Writers must be serialised by the caller. The back links and the node
+/// count belong to the writer. The list is linear rather than circular, so a
+/// reader's walk always ends at null even while nodes are being removed.
+/// @tparam Readers maximum number of reader handles at once
+template <typename NodeStorageType, uint8_t Readers, typename... StorageArgs>
+class basic_rculist
+{
+#if defined(__AVR__)
+    static const size_t slot_alignment = 1U; ///< no caches to share
+#else
+    static const size_t slot_alignment = 64U; ///< one cache line per reader
+#endif
+
+    /// @brief epoch announcement of one reader, alone on its cache line
+    struct alignas(slot_alignment) readerslot
+    {
+        readerslot() : epoch(0U), claimed(0U) {}
+        listatomic<uint32_t> epoch;  ///< epoch of the current read section, 0 outside one
+        listatomic<uint8_t> claimed; ///< 1 while a reader handle owns the slot
+    };
+
+public:
+    /// @brief list node; the payload is v
+    typedef rculistnode<NodeStorageType> rcunode;
+
+    /// @brief forward iterator over the payloads, for use inside a read section
+    class iterator
+    {
+    public:
+        explicit iterator(rcunode *node) : current(node) {}
+        const NodeStorageType &operator*() const { return current->v; }
+        const NodeStorageType *operator->() const { return &current->v; }
+        iterator &operator++()
+        {
+            current = current->n.load();
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return current == other.current; }
+        bool operator!=(const iterator &other) const { return current != other.current; }
+
+    private:
+        rcunode *current; ///< node the iterator is at
+    };
+
+    /// @brief per-thread read handle owning one reader slot
+    class reader
+    {
+    public:
+        /// @brief claims a free reader slot
+        /// @param shared list to read
+        explicit reader(basic_rculist &shared) : list(shared), slot(shared.claim_slot()) {}
+        reader(const reader &) = delete;
+        reader &operator=(const reader &) = delete;
+        ~reader()
+        {
+            if (slot != nullptr)
+            {
+                slot->epoch.store(0U);
+                slot->claimed.store(0U);
+            }
+        }
+
+        /// @brief checks that a reader slot was available
+        bool isValid() const { return slot != nullptr; }
+
+        /// @brief enters a read section; nodes seen stay valid until unlock()
+        void lock()
+        {
+            slot->epoch.store(list.epoch.load());
+            listfence(); // announce the epoch before reading any link
+        }
+
+        /// @brief leaves the read section
+        void unlock()
+        {
+            slot->epoch.store(0U);
+        }
+
+        /// @brief first payload, only between lock() and unlock()
+        iterator begin() const { return iterator(list.head.load()); }
+
+        /// @brief iterator past the last payload
+        iterator end() const { return iterator(nullptr); }
+
+    private:
+        basic_rculist &list; ///< list being read
+        readerslot *slot; ///< claimed slot, null if none was free
+    };
+
+    /// @brief scoped read section
+    class readguard
+    {
+    public:
+        explicit readguard(reader &owner) : held(owner) { held.lock(); }
+        readguard(const readguard &) = delete;
+        readguard &operator=(const readguard &) = delete;
+        ~readguard() { held.unlock(); }
+
+    private:
+        reader &held; ///< reader whose section this is
+    };
+
+    basic_rculist() : head(nullptr), tail(nullptr), list_nodes(0U), epoch(1U), retired_head(nullptr), retired_tail(nullptr), retired_nodes(0U) {}
+    basic_rculist(const basic_rculist &) = delete;
+    basic_rculist &operator=(const basic_rculist &) = delete;
+
+    /// @brief frees every node; no reader may be inside a read section
+    ~basic_rculist()
+    {
+        rcunode *node = head.load();
+        while (node != nullptr)
+        {
+            rcunode *next = node->n.load();
+            delete node;
+            node = next;
+        }
+        free_retired(0U, true);
+    }
+
+    /// @brief publishes a new node at the head
+    /// @param args Arguments to construct the storage
+    /// @return node that was inserted, or null on allocation failure
+    rcunode *insertAtBeginning(StorageArgs... args)
+    {
+        rcunode *node = new rcunode(args...);
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+        rcunode *first = head.load();
+        node->n.store(first); // complete before it becomes reachable
+        if (first != nullptr)
+        {
+            first->p = node;
+        }
+        else
+        {
+            tail = node;
+        }
+        head.store(node);
+        list_nodes++;
+        return node;
+    }
+
+    /// @brief publishes a new node at the tail
+    /// @param args Arguments to construct the storage
+    /// @return node that was inserted, or null on allocation failure
+    rcunode *insertAtEnd(StorageArgs... args)
+    {
+        rcunode *node = new rcunode(args...);
+        if (node == nullptr)
+        {
+            return nullptr;
+        }
+        node->p = tail;
+        if (tail != nullptr)
+        {
+            tail->n.store(node);
+        }
+        else
+        {
+            head.store(node);
+        }
+        tail = node;
+        list_nodes++;
+        return node;
+    }
+
+    /// @brief unlinks a node in O(1) and retires it
+    /// @details readers already past the unlink may still read the node; it is
+    /// freed by a later reclaim() once they have all left their read sections
+    /// @param node node of this list
+    /// @return false if node is null
+    bool deleteNode(rcunode *node)
+    {
+        if (node == nullptr)
+        {
+            return false;
+        }
+        rcunode *next = node->n.load();
+        if (node->p != nullptr)
+        {
+            node->p->n.store(next);
+        }
+        else
+        {
+            head.store(next);
+        }
+        if (next != nullptr)
+        {
+            next->p = node->p;
+        }
+        else
+        {
+            tail = node->p;
+        }
+        list_nodes--;
+        retire(node);
+        return true;
+    }
+
+    /// @brief unlinks and retires the first node
+    /// @return false if the list is empty
+    bool removeAtBeginning()
+    {
+        return deleteNode(head.load());
+    }
+
+    /// @brief unlinks and retires every node whose payload matches, in one pass
+    /// @param pred callable taking const NodeStorageType & and returning true to delete
+    /// @return number of nodes deleted
+    template <typename Predicate>
+    size_t removeIf(Predicate pred)
+    {
+        size_t removed = 0U;
+        rcunode *node = head.load();
+        while (node != nullptr)
+        {
+            rcunode *next = node->n.load();
+            if (pred(static_cast<const NodeStorageType &>(node->v)))
+            {
+                deleteNode(node);
+                ++removed;
+            }
+            node = next;
+        }
+        return removed;
+    }
+
+    /// @brief frees the retired nodes no reader can still hold, without waiting
+    /// @return number of nodes freed
+    size_t reclaim()
+    {
+        if (retired_nodes == 0U)
+        {
+            return 0U;
+        }
+        uint32_t next_epoch = epoch.fetchAdd(1U) + 1U;
+        if (next_epoch == 0U)
+        {
+            next_epoch = epoch.fetchAdd(1U) + 1U; // 0 marks an idle reader slot
+        }
+        listfence(); // publish the new epoch before looking at the readers
+        uint32_t oldest = next_epoch;
+        for (uint8_t i = 0; i < Readers; ++i)
+        {
+            uint32_t entered = slots[i].epoch.load();
+            if (entered != 0U && (int32_t)(entered - oldest) < 0)
+            {
+                oldest = entered;
+            }
+        }
+        return free_retired(oldest, false);
+    }
+
+    /// @brief waits until every retired node has been freed
+    /// @details blocks the writer only while a reader is inside a section that
+    /// began before the last unlink
+    void synchronize()
+    {
+        while (retired_nodes > 0U)
+        {
+            reclaim();
+        }
+    }
+
+    /// @brief gets the number of nodes, as seen by the writer
+    size_t size() const
+    {
+        return list_nodes;
+    }
+
+    /// @brief gets the number of unlinked nodes not yet freed
+    size_t retired() const
+    {
+        return retired_nodes;
+    }
+
+private:
+    /// @brief retired nodes are reclaimed in batches of this size
+    static const size_t reclaim_batch = 32U;
+
+    /// @brief finds and claims a free reader slot
+    /// @return the slot, or null if all are taken
+    readerslot *claim_slot()
+    {
+        for (uint8_t i = 0; i < Readers; ++i)
+        {
+            uint8_t expected = 0U;
+            if (slots[i].claimed.compareExchange(expected, 1U))
+            {
+                return &slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief queues an unlinked node for reclamation
+    /// @param node node no longer reachable from head
+    void retire(rcunode *node)
+    {
+        node->retired = nullptr;
+        node->retired_epoch = epoch.load();
+        if (retired_tail != nullptr)
+        {
+            retired_tail->retired = node;
+        }
+        else
+        {
+            retired_head = node;
+        }
+        retired_tail = node;
+        if (++retired_nodes >= reclaim_batch)
+        {
+            reclaim();
+        }
+    }
+
+    /// @brief frees retired nodes, oldest first
+    /// @param oldest epoch of the oldest active reader; nodes retired before it are free
+    /// @param all free every retired node regardless of readers
+    /// @return number of nodes freed
+    size_t free_retired(uint32_t oldest, bool all)
+    {
+        size_t freed = 0U;
+        while (retired_head != nullptr && (all || (int32_t)(retired_head->retired_epoch - oldest) < 0))
+        {
+            rcunode *node = retired_head;
+            retired_head = node->retired;
+            delete node;
+            ++freed;
+        }
+        if (retired_head == nullptr)
+        {
+            retired_tail = nullptr;
+        }
+        retired_nodes -= freed;
+        return freed;
+    }
+
+    listatomic<rcunode *> head; ///< first node, read by readers
+    rcunode *tail;              ///< last node, writer only
+    size_t list_nodes;          ///< node count, writer only
+    listatomic<uint32_t> epoch; ///< global epoch, advanced by reclaim()
+    rcunode *retired_head;      ///< oldest retired node
+    rcunode *retired_tail;      ///< newest retired node
+    size_t retired_nodes;       ///< number of retired nodes
+    readerslot slots[Readers];  ///< one per reader handle
+};
+
+/// @brief rculist with room for 8 concurrent reader handles
+template <typename NodeStorageType, typename... StorageArgs>
+using rculist = basic_rculist<NodeStorageType, 8, StorageArgs...>;
+
+#endif // RCU_LIST_H
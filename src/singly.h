@@ -2,31 +2,96 @@
 #define SINGLY_LINKED_LIST_H
 
 #include <Arduino.h>
+#include "listtraits.h"
+#include "nodepool.h"
+
+/// @brief list node with pointer to next and storage
+template <typename NodeStorageType>
+struct singlylistnode
+{
+    /// @brief list node structure, contains pointer to next and storage
+    /// @param storage_pointer pointer of type NodeStorageType
+    singlylistnode(NodeStorageType *storage_pointer);
+    NodeStorageType *sp; ///< pointer to storage
+    singlylistnode *n;   ///< pointer to next list member or null
+};
 
 /// @brief inheritable linked-list framework
-template <typename NodeStorageType, typename... StorageArgs>
-class singlylist
+/// @tparam Traits list configuration, see listtraits
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+class basic_singlylist : private nodepool<singlylistnode<NodeStorageType>, NodeStorageType, Traits>
 {
 public:
-    /// @brief Constructor for the linked-list
-    singlylist();
+    /// @brief list node with pointer to next and storage
+    typedef singlylistnode<NodeStorageType> singlynode;
 
-    /// @brief Destructor for the linked-list
-    ~singlylist();
+    /// @brief node count and position type, see listtraits::size_type
+    typedef typename Traits::size_type size_type;
+
+private:
+    /// @brief forward walk prefetcher configured by Traits::prefetch_distance
+    typedef prefetchcursor<singlynode, NodeStorageType, &singlynode::n, Traits::prefetch_distance> prefetcher;
 
-    /// @brief list node with pointer to next and void* to storage
-    struct singlynode
+public:
+    /// @brief forward iterator over the stored payloads, head to tail
+    class iterator
     {
-        /// @brief list node structure, contains pointer to next and storage
-        /// @param storage_pointer pointer of type NodeStorageType
-        singlynode(NodeStorageType *storage_pointer);
-        NodeStorageType *sp; ///< pointer to storage
-        singlynode *n;       ///< pointer to next list member or null
+    public:
+        /// @param node first node to visit, null for end()
+        /// @param count number of nodes from node to the tail
+        iterator(singlynode *node, size_type count) : current(node), ahead(node, count > 0 ? count - 1 : 0) {}
+        NodeStorageType &operator*() const { return *current->sp; }
+        NodeStorageType *operator->() const { return current->sp; }
+        /// @brief node the iterator is at
+        singlynode *node() const { return current; }
+        iterator &operator++()
+        {
+            ahead.advance();
+            current = current->n;
+            return *this;
+        }
+        bool operator==(const iterator &other) const { return current == other.current; }
+        bool operator!=(const iterator &other) const { return current != other.current; }
+
+    private:
+        singlynode *current; ///< node the iterator is at
+        prefetcher ahead;    ///< prefetches the nodes about to be visited
     };
 
+    /// @brief Constructor for the linked-list
+    basic_singlylist();
+
+    /// @brief Deep copy; the clone is built in a single pass
+    /// @param other list to copy
+    basic_singlylist(const basic_singlylist &other);
+
+    /// @brief Move constructor; steals other's nodes and leaves it empty
+    /// @details O(1) unless Traits::inline_nodes > 0, in which case nodes in
+    /// other's inline slots are moved into this list's inline slots. With
+    /// Traits::slab_slots > 0 the two lists also exchange their slabs
+    /// @param other list to move from
+    basic_singlylist(basic_singlylist &&other) noexcept;
+
+    /// @brief Destructor for the linked-list
+    ~basic_singlylist();
+
+    /// @brief replaces the contents with a deep copy of other
+    /// @param other list to copy
+    /// @return this list
+    basic_singlylist &operator=(const basic_singlylist &other);
+
+    /// @brief replaces the contents with other's nodes and leaves other empty
+    /// @param other list to move from
+    /// @return this list
+    basic_singlylist &operator=(basic_singlylist &&other) noexcept;
+
+    /// @brief exchanges the contents of two lists
+    /// @param other list to swap with
+    void swap(basic_singlylist &other) noexcept;
+
     /// @brief inserts a node at the beginning of the list
     /// @param args Arguments to construct the storage
-    /// @return node that was inserted
+    /// @return node that was inserted, or null on allocation failure
     singlynode *insertAtBeginning(StorageArgs... args);
 
     /// @brief clears the list and deallocates memory
@@ -34,36 +99,133 @@ public:
 
     /// @brief inserts a node at the end of the list
     /// @param args Arguments to construct the storage
-    /// @return node that was inserted
+    /// @return node that was inserted, or null on allocation failure
     singlynode *insertAtEnd(StorageArgs... args);
 
+    /// @brief inserts a copy of an existing payload at the end of the list
+    /// @param value payload to copy
+    /// @return node that was inserted, or null on allocation failure
+    singlynode *insertCopyAtEnd(const NodeStorageType &value);
+
     /// @brief inserts node at position
     /// @param position 1-... position in the array to insert
     /// @param args Arguments to construct the storage
     /// @return null node on error
-    singlynode *insertAtPosition(int position, StorageArgs... args);
+    singlynode *insertAtPosition(size_type position, StorageArgs... args);
 
     /// @brief deletes the node at position
     /// @param position 1-... position of node to delete
-    bool deleteFromPosition(int position);
+    bool deleteFromPosition(size_type position);
+
+    /// @brief deletes the nodes from position first to position last, inclusive
+    /// @details walks to the node before first once, then unlinks the run
+    /// @param first 1-... position of the first node to delete
+    /// @param last 1-... position of the last node to delete
+    /// @return true on success, false if the range is empty or out of range
+    bool deleteRange(size_type first, size_type last);
+
+    /// @brief deletes every node whose payload matches, in one pass
+    /// @param pred callable taking NodeStorageType & and returning true to delete
+    /// @return number of nodes deleted
+    template <typename Predicate>
+    size_type removeIf(Predicate pred);
+
+    /// @brief reverses the order of the nodes by relinking them
+    void reverse();
+
+    /// @brief stable partition: moves the nodes whose payload matches in front
+    /// of the rest, keeping the relative order within both groups
+    /// @param pred callable taking NodeStorageType & and returning true for the front group
+    /// @return first node of the back group, or null if every node matches
+    template <typename Predicate>
+    singlynode *partition(Predicate pred);
+
+    /// @brief deletes each node whose payload equals the payload before it
+    /// @param eq callable taking two NodeStorageType & and returning true if equal
+    /// @return number of nodes deleted
+    template <typename Equal>
+    size_type unique(Equal eq);
 
     /// @brief gets the storage pointer at position
     /// @param position 1-... position in the list
     /// @return pointer to storage at position
-    NodeStorageType *getStoragePtr(int position);
+    NodeStorageType *getStoragePtr(size_type position);
 
     /// @brief gets the node at position
     /// @param position 1-... position in the list
     /// @return pointer to node at position
-    singlynode *getNode(int position);
+    singlynode *getNode(size_type position);
 
     /// @brief removes a node from the beginning of the list
     void removeAtBeginning();
 
+    /// @brief gets the number of list members
+    /// @return node count
+    size_type size() const;
+
+    /// @brief copies payloads, head first, into an array
+    /// @details one linear walk; trivially copyable payloads are copied with memcpy
+    /// @param out array of at least count constructed payloads
+    /// @param count maximum number of payloads to copy
+    /// @return number of payloads copied, min(count, size())
+    size_type copyTo(NodeStorageType *out, size_type count) const;
+
+    /// @brief copies payloads, head first, into a fixed-size array
+    /// @param out array to fill
+    /// @return number of payloads copied, min(N, size())
+    template <size_t N>
+    size_type toArray(NodeStorageType (&out)[N]) const
+    {
+        return copyTo(out, N < (size_t)sizelimit<size_type>::max ? (size_type)N : sizelimit<size_type>::max);
+    }
+
+    /// @brief appends copies of an array of payloads
+    /// @param values payloads to append, in order
+    /// @param count number of payloads
+    /// @return number of payloads appended; less than count on allocation failure
+    size_type fromArray(const NodeStorageType *values, size_type count);
+
+    /// @brief preallocates node slots so inserts up to capacity nodes never
+    /// call the allocator
+    /// @details slots freed by deletes are kept while the list is below the
+    /// reserved capacity. Needs Traits::reservable or slabs (a compile error
+    /// otherwise), so other lists carry no spare-slot state.
+    /// @param capacity node count to hold without allocating
+    /// @return false if an allocation failed; slots allocated so far are kept
+    bool reserve(size_type capacity);
+
+    /// @brief gets the number of nodes the list holds before allocating again
+    /// @return node count plus free preallocated and inline slots
+    size_type capacity() const;
+
+    /// @brief frees the preallocated slots not holding a node and drops the reservation
+    void shrink_to_fit();
+
+    /// @brief reports the bytes the list holds: object, node links, payloads,
+    /// unused slots and estimated allocator overhead
+    /// @return byte counts, see listmemory
+    listmemory memoryUsage() const;
+
+    /// @brief moves every heap node into one new slab in list order, so a walk
+    /// reads memory front to back; needs Traits::slab_slots > 0
+    /// @details Invalidates every node and payload pointer, reference and
+    /// iterator taken before the call; getLastAccessedNode() follows its node.
+    /// Nodes in inline slots stay put. Spare slots and the reservation are
+    /// dropped as by shrink_to_fit(). Needs room for a second copy of the heap
+    /// nodes while it runs.
+    /// @return false if the new slab could not be allocated; the list is unchanged
+    bool compact();
+
     /// @brief gets the last accessed node
     /// @return pointer to the last accessed node
     singlynode *getLastAccessedNode();
 
+    /// @brief iterator at the head, for range-based for loops
+    iterator begin();
+
+    /// @brief iterator past the tail
+    iterator end();
+
     /// @brief gets the storage pointer of the last accessed node
     /// @return pointer to storage of the last accessed node
     NodeStorageType *getLastAccessedNodeStoragePtr();
@@ -72,47 +234,144 @@ private:
     singlynode *head;     ///< list head
     singlynode *tail;     ///< list tail
     singlynode *lastnode; ///< last accessed node
-    size_t list_nodes;    ///< number of list members
+    size_type list_nodes; ///< number of list members
 
     /// @brief creates a new node
     /// @param args Arguments to construct the storage
     /// @return pointer to the created node
     singlynode *create_node(StorageArgs... args);
 
+    /// @brief creates a new node holding a copy of value
+    /// @param value payload to copy
+    /// @return pointer to the created node
+    singlynode *create_node_copy(const NodeStorageType &value);
+
+    /// @brief links a node after the tail
+    /// @param temp node to link
+    /// @return the linked node
+    singlynode *link_at_end(singlynode *temp);
+
     /// @brief deallocates a node
     /// @param dealloc_node pointer to the node to deallocate
     void deallocate_node(singlynode *dealloc_node);
 
+    /// @brief unlinks the node after prev (the head if prev is null) and deallocates it
+    /// @param prev node before the one to delete, or null
+    /// @param node node to delete
+    void erase_after(singlynode *prev, singlynode *node);
+
     /// @brief deletes a node at position
     /// @param position 1-... position of node to delete
-    void delete_node(int position);
+    void delete_node(size_type position);
+
+    /// @brief appends copies of other's payloads
+    /// @param other list to copy from
+    void copy_nodes(const basic_singlylist &other);
+
+    /// @brief takes over other's nodes, relocating any that sit in other's inline slots
+    /// @param other list to move from, left empty
+    void take_nodes(basic_singlylist &other);
 };
 
+/// @brief singly linked-list with the default listtraits
+template <typename NodeStorageType, typename... StorageArgs>
+using singlylist = basic_singlylist<listtraits, NodeStorageType, StorageArgs...>;
+
 // Implementation of template functions
 
-template <typename NodeStorageType, typename... StorageArgs>
-singlylist<NodeStorageType, StorageArgs...>::singlylist()
+template <typename NodeStorageType>
+singlylistnode<NodeStorageType>::singlylistnode(NodeStorageType *storage_pointer)
+    : sp(storage_pointer), n(nullptr)
+{
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::basic_singlylist()
     : head(nullptr), tail(nullptr), lastnode(nullptr), list_nodes(0U)
 {
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-singlylist<NodeStorageType, StorageArgs...>::~singlylist()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::basic_singlylist(const basic_singlylist &other)
+    : head(nullptr), tail(nullptr), lastnode(nullptr), list_nodes(0U)
+{
+    copy_nodes(other);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::basic_singlylist(basic_singlylist &&other) noexcept
+    : head(nullptr), tail(nullptr), lastnode(nullptr), list_nodes(0U)
+{
+    take_nodes(other);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::~basic_singlylist()
 {
     clear();
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-singlylist<NodeStorageType, StorageArgs...>::singlynode::singlynode(NodeStorageType *storage_pointer)
-    : sp(storage_pointer), n(nullptr)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_singlylist<Traits, NodeStorageType, StorageArgs...> &
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::operator=(const basic_singlylist &other)
 {
+    if (this != &other)
+    {
+        clear();
+        copy_nodes(other);
+    }
+    return *this;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename singlylist<NodeStorageType, StorageArgs...>::singlynode *
-singlylist<NodeStorageType, StorageArgs...>::insertAtBeginning(StorageArgs... args)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+basic_singlylist<Traits, NodeStorageType, StorageArgs...> &
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::operator=(basic_singlylist &&other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+        take_nodes(other);
+    }
+    return *this;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::swap(basic_singlylist &other) noexcept
+{
+    if (Traits::inline_nodes > 0)
+    {
+        basic_singlylist temp(static_cast<basic_singlylist &&>(other));
+        other = static_cast<basic_singlylist &&>(*this);
+        *this = static_cast<basic_singlylist &&>(temp);
+        return;
+    }
+    singlynode *node = head;
+    head = other.head;
+    other.head = node;
+    node = tail;
+    tail = other.tail;
+    other.tail = node;
+    node = lastnode;
+    lastnode = other.lastnode;
+    other.lastnode = node;
+    size_type count = list_nodes;
+    list_nodes = other.list_nodes;
+    other.list_nodes = count;
+    if (Traits::slab_slots > 0)
+    {
+        this->swap_slabs(other);
+    }
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::insertAtBeginning(StorageArgs... args)
 {
     singlynode *temp = create_node(args...);
+    if (temp == nullptr)
+    {
+        return nullptr;
+    }
     if (list_nodes == 0) // empty list
     {
         head = tail = temp;
@@ -126,20 +385,43 @@ singlylist<NodeStorageType, StorageArgs...>::insertAtBeginning(StorageArgs... ar
     return head;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-void singlylist<NodeStorageType, StorageArgs...>::clear()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::clear()
 {
+    if (list_nodes == 0)
+    {
+        return;
+    }
+    prefetcher ahead(head, list_nodes - 1);
     while (list_nodes > 0)
     {
+        ahead.advance();
         removeAtBeginning();
     }
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename singlylist<NodeStorageType, StorageArgs...>::singlynode *
-singlylist<NodeStorageType, StorageArgs...>::insertAtEnd(StorageArgs... args)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::insertAtEnd(StorageArgs... args)
 {
-    singlynode *temp = create_node(args...);
+    return link_at_end(create_node(args...));
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::insertCopyAtEnd(const NodeStorageType &value)
+{
+    return link_at_end(create_node_copy(value));
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::link_at_end(singlynode *temp)
+{
+    if (temp == nullptr)
+    {
+        return nullptr;
+    }
     if (list_nodes == 0) // empty list
     {
         head = tail = temp;
@@ -153,11 +435,11 @@ singlylist<NodeStorageType, StorageArgs...>::insertAtEnd(StorageArgs... args)
     return tail;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename singlylist<NodeStorageType, StorageArgs...>::singlynode *
-singlylist<NodeStorageType, StorageArgs...>::insertAtPosition(int position, StorageArgs... args)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::insertAtPosition(size_type position, StorageArgs... args)
 {
-    if (position < 1 || position > (int)(list_nodes + 1))
+    if (position < 1 || position - 1 > list_nodes)
     {
         return nullptr; // position out of range
     }
@@ -165,7 +447,7 @@ singlylist<NodeStorageType, StorageArgs...>::insertAtPosition(int position, Stor
     {
         return insertAtBeginning(args...);
     }
-    if (position == (int)(list_nodes + 1))
+    if (position - 1 == list_nodes)
     {
         return insertAtEnd(args...);
     }
@@ -182,10 +464,10 @@ singlylist<NodeStorageType, StorageArgs...>::insertAtPosition(int position, Stor
     return temp;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-bool singlylist<NodeStorageType, StorageArgs...>::deleteFromPosition(int position)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_singlylist<Traits, NodeStorageType, StorageArgs...>::deleteFromPosition(size_type position)
 {
-    if (position < 1 || position > (int)list_nodes)
+    if (position < 1 || position > list_nodes)
     {
         return false; // position out of range
     }
@@ -193,89 +475,374 @@ bool singlylist<NodeStorageType, StorageArgs...>::deleteFromPosition(int positio
     return true;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-NodeStorageType *singlylist<NodeStorageType, StorageArgs...>::getStoragePtr(int position)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_singlylist<Traits, NodeStorageType, StorageArgs...>::deleteRange(size_type first, size_type last)
+{
+    if (first < 1 || last < first || last > list_nodes)
+    {
+        return false; // range empty or out of range
+    }
+    singlynode *prev = first == 1 ? nullptr : getNode(first - 1);
+    for (size_type k = last - first + 1; k > 0; --k) // counts down: last may be size_type's maximum
+    {
+        erase_after(prev, prev == nullptr ? head : prev->n);
+    }
+    return true;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+template <typename Predicate>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::removeIf(Predicate pred)
+{
+    size_type removed = 0U;
+    singlynode *prev = nullptr;
+    singlynode *current = head;
+    prefetcher ahead(head, list_nodes > 0 ? list_nodes - 1 : 0);
+    while (current != nullptr)
+    {
+        ahead.advance();
+        singlynode *next = current->n;
+        if (pred(*current->sp))
+        {
+            erase_after(prev, current);
+            ++removed;
+        }
+        else
+        {
+            prev = current;
+        }
+        current = next;
+    }
+    return removed;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::reverse()
+{
+    singlynode *prev = nullptr;
+    singlynode *current = head;
+    tail = head;
+    while (current != nullptr)
+    {
+        singlynode *next = current->n;
+        current->n = prev;
+        prev = current;
+        current = next;
+    }
+    head = prev;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+template <typename Predicate>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::partition(Predicate pred)
+{
+    singlynode *front_head = nullptr;
+    singlynode *front_tail = nullptr;
+    singlynode *back_head = nullptr;
+    singlynode *back_tail = nullptr;
+    for (singlynode *current = head; current != nullptr; current = current->n)
+    {
+        bool front = pred(*current->sp);
+        singlynode *&group_head = front ? front_head : back_head;
+        singlynode *&group_tail = front ? front_tail : back_tail;
+        if (group_head == nullptr)
+        {
+            group_head = current;
+        }
+        else
+        {
+            group_tail->n = current;
+        }
+        group_tail = current;
+    }
+    if (back_tail != nullptr)
+    {
+        back_tail->n = nullptr;
+    }
+    if (front_tail != nullptr)
+    {
+        front_tail->n = back_head;
+        head = front_head;
+    }
+    else
+    {
+        head = back_head;
+    }
+    tail = back_tail != nullptr ? back_tail : front_tail;
+    return back_head;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+template <typename Equal>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::unique(Equal eq)
+{
+    size_type removed = 0U;
+    singlynode *prev = head;
+    while (prev != nullptr && prev->n != nullptr)
+    {
+        if (eq(*prev->sp, *prev->n->sp))
+        {
+            erase_after(prev, prev->n);
+            ++removed;
+        }
+        else
+        {
+            prev = prev->n;
+        }
+    }
+    return removed;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+NodeStorageType *basic_singlylist<Traits, NodeStorageType, StorageArgs...>::getStoragePtr(size_type position)
 {
     singlynode *access = getNode(position);
     return access ? access->sp : nullptr;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename singlylist<NodeStorageType, StorageArgs...>::singlynode *
-singlylist<NodeStorageType, StorageArgs...>::getNode(int position)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::getNode(size_type position)
 {
-    if (position < 1 || position > (int)list_nodes)
+    if (position < 1 || position > list_nodes)
     {
         return nullptr; // position out of range
     }
     singlynode *current = head;
-    for (int i = 1; i < position; ++i)
+    prefetcher ahead(head, position - 1);
+    for (size_type i = 1; i < position; ++i)
     {
+        ahead.advance();
         current = current->n;
     }
     lastnode = current;
     return current;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-void singlylist<NodeStorageType, StorageArgs...>::removeAtBeginning()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::removeAtBeginning()
 {
     if (list_nodes == 0)
         return;
 
-    singlynode *temp = head;
-    head = head->n;
-    deallocate_node(temp);
-    if (--list_nodes == 0)
+    erase_after(nullptr, head);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::size() const
+{
+    return list_nodes;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::copyTo(NodeStorageType *out, size_type count) const
+{
+    size_type copied = 0U;
+    singlynode *current = head;
+    size_type walk = count < list_nodes ? count : list_nodes;
+    prefetcher ahead(head, walk > 0 ? walk - 1 : 0);
+    while (copied < count && current != nullptr)
     {
-        tail = nullptr;
+        ahead.advance();
+        assign_payload(out[copied++], *current->sp);
+        current = current->n;
     }
+    return copied;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename singlylist<NodeStorageType, StorageArgs...>::singlynode *
-singlylist<NodeStorageType, StorageArgs...>::getLastAccessedNode()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::fromArray(const NodeStorageType *values, size_type count)
+{
+    size_type appended = 0U;
+    while (appended < count && link_at_end(create_node_copy(values[appended])) != nullptr)
+    {
+        ++appended;
+    }
+    return appended;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_singlylist<Traits, NodeStorageType, StorageArgs...>::reserve(size_type capacity)
+{
+    static_assert(Traits::reservable || Traits::slab_slots > 0, "reserve() needs a list that keeps spare slots, e.g. reservetraits or slabtraits<N>");
+    return this->reserve_slots(list_nodes, capacity);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::size_type
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::capacity() const
+{
+    return list_nodes + this->available_slots();
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::shrink_to_fit()
+{
+    this->shrink_slots();
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+listmemory basic_singlylist<Traits, NodeStorageType, StorageArgs...>::memoryUsage() const
+{
+    return this->slot_usage(list_nodes, sizeof(*this));
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+bool basic_singlylist<Traits, NodeStorageType, StorageArgs...>::compact()
+{
+    static_assert(Traits::slab_slots > 0, "compact() needs a list that allocates from slabs, e.g. slabtraits<N>");
+    size_type heap = this->heap_nodes(list_nodes);
+    if (heap == 0)
+    {
+        this->shrink_slots();
+        return true;
+    }
+    singlynode *first_slot = this->take_slab(heap);
+    if (first_slot == nullptr)
+    {
+        return false;
+    }
+    singlynode *slot = first_slot;
+    singlynode *previous = nullptr;
+    for (singlynode *current = head; current != nullptr;)
+    {
+        singlynode *next = current->n;
+        singlynode *node = current;
+        if (!this->is_inline(current))
+        {
+            node = slot;
+            slot = this->next_slot(slot);
+            node->sp = new (node->sp) NodeStorageType(static_cast<NodeStorageType &&>(*current->sp));
+            current->sp->~NodeStorageType();
+            if (current == lastnode)
+            {
+                lastnode = node;
+            }
+        }
+        if (previous != nullptr)
+        {
+            previous->n = node;
+        }
+        else
+        {
+            head = node;
+        }
+        previous = node;
+        current = next;
+    }
+    tail = previous;
+    if (tail != nullptr)
+    {
+        tail->n = nullptr;
+    }
+    this->finish_compaction(first_slot); // every other slab is empty now
+    return true;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::getLastAccessedNode()
 {
     return lastnode;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-NodeStorageType *singlylist<NodeStorageType, StorageArgs...>::getLastAccessedNodeStoragePtr()
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+NodeStorageType *basic_singlylist<Traits, NodeStorageType, StorageArgs...>::getLastAccessedNodeStoragePtr()
 {
     return lastnode ? lastnode->sp : nullptr;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-typename singlylist<NodeStorageType, StorageArgs...>::singlynode *
-singlylist<NodeStorageType, StorageArgs...>::create_node(StorageArgs... args)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::iterator
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::begin()
+{
+    return iterator(head, list_nodes);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::iterator
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::end()
 {
-    NodeStorageType *sp = new NodeStorageType{args...};
-    if (sp == nullptr)
+    return iterator(nullptr, 0U);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::create_node(StorageArgs... args)
+{
+    if (list_nodes == sizelimit<size_type>::max)
+    {
+        return nullptr; // size_type cannot count another node
+    }
+    singlynode *new_node = this->acquire_slot();
+    if (new_node == nullptr)
     {
         return nullptr;
     }
-    singlynode *new_node = new singlynode(sp);
+    new_node->sp = new (new_node->sp) NodeStorageType{args...};
+    lastnode = new_node;
+    return new_node;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+typename basic_singlylist<Traits, NodeStorageType, StorageArgs...>::singlynode *
+basic_singlylist<Traits, NodeStorageType, StorageArgs...>::create_node_copy(const NodeStorageType &value)
+{
+    if (list_nodes == sizelimit<size_type>::max)
+    {
+        return nullptr; // size_type cannot count another node
+    }
+    singlynode *new_node = this->acquire_slot();
     if (new_node == nullptr)
     {
-        delete sp;
         return nullptr;
     }
+    new_node->sp = copy_payload(new_node->sp, value);
     lastnode = new_node;
     return new_node;
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-void singlylist<NodeStorageType, StorageArgs...>::deallocate_node(singlynode *dealloc_node)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::deallocate_node(singlynode *dealloc_node)
 {
     if (dealloc_node != nullptr)
     {
-        delete dealloc_node->sp;
-        delete dealloc_node;
+        dealloc_node->sp->~NodeStorageType();
+        this->release_slot(dealloc_node, list_nodes - 1);
     }
 }
 
-template <typename NodeStorageType, typename... StorageArgs>
-void singlylist<NodeStorageType, StorageArgs...>::delete_node(int position)
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::erase_after(singlynode *prev, singlynode *node)
+{
+    if (prev == nullptr)
+    {
+        head = node->n;
+    }
+    else
+    {
+        prev->n = node->n;
+    }
+    if (node == tail)
+    {
+        tail = prev;
+    }
+    if (node == lastnode)
+    {
+        lastnode = nullptr;
+    }
+    deallocate_node(node);
+    list_nodes--;
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::delete_node(size_type position)
 {
     if (position == 1)
     {
@@ -284,14 +851,62 @@ void singlylist<NodeStorageType, StorageArgs...>::delete_node(int position)
     }
 
     singlynode *prev = getNode(position - 1);
-    singlynode *current = prev->n;
-    prev->n = current->n;
-    if (current == tail)
+    erase_after(prev, prev->n);
+}
+
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::copy_nodes(const basic_singlylist &other)
+{
+    for (singlynode *source = other.head; source != nullptr; source = source->n)
     {
-        tail = prev;
+        if (link_at_end(create_node_copy(*source->sp)) == nullptr)
+        {
+            return; // allocation failure, keep the partial copy
+        }
     }
-    deallocate_node(current);
-    list_nodes--;
 }
 
-#endif // SINGLY_LINKED_LIST_H
\ No newline at end of file
+template <typename Traits, typename NodeStorageType, typename... StorageArgs>
+void basic_singlylist<Traits, NodeStorageType, StorageArgs...>::take_nodes(basic_singlylist &other)
+{
+    if (Traits::inline_nodes == 0)
+    {
+        head = other.head;
+        tail = other.tail;
+        lastnode = other.lastnode;
+        list_nodes = other.list_nodes;
+    }
+    else
+    {
+        // other's inline nodes cannot leave other; move their payloads into
+        // our inline slots, which are all free because this list is empty
+        singlynode *source = other.head;
+        while (source != nullptr)
+        {
+            singlynode *next = source->n;
+            singlynode *node = source;
+            if (other.is_inline(source))
+            {
+                node = this->take_inline();
+                node->sp = new (node->sp) NodeStorageType(static_cast<NodeStorageType &&>(*source->sp));
+                source->sp->~NodeStorageType();
+                other.give_inline(source);
+            }
+            node->n = nullptr;
+            link_at_end(node);
+            if (source == other.lastnode)
+            {
+                lastnode = node;
+            }
+            source = next;
+        }
+    }
+    if (Traits::slab_slots > 0)
+    {
+        this->swap_slabs(other); // the nodes stay in other's slabs
+    }
+    other.head = other.tail = other.lastnode = nullptr;
+    other.list_nodes = 0U;
+}
+
+#endif // SINGLY_LINKED_LIST_H
@@ -0,0 +1,138 @@
+#ifndef STATIC_LIST_H
+#define STATIC_LIST_H
+
+#include <Arduino.h>
+#include "nodepool.h"
+
+/// @brief compile-time index pack used to expand staticlist node initializers
+template <size_t... Indices>
+struct staticindices
+{
+};
+
+/// @brief builds staticindices<0, 1, ..., Count - 1>
+template <size_t Count, size_t... Indices>
+struct makestaticindices : makestaticindices<Count - 1, Count - 1, Indices...>
+{
+};
+
+template <size_t... Indices>
+struct makestaticindices<0, Indices...>
+{
+    typedef staticindices<Indices...> type;
+};
+
+/// @brief fixed, read-only linked-list that can be fully built at compile time
+/// @details Payloads and node links live inside the object, so a `constexpr`
+/// staticlist is placed in rodata with no runtime construction and no heap use.
+/// On AVR, constexpr data is still copied to RAM at startup unless the object is
+/// placed in PROGMEM, which the pointer-returning interface does not support.
+template <typename NodeStorageType, size_t Capacity>
+class staticlist
+{
+public:
+    static_assert(Capacity > 0, "staticlist needs at least one element");
+
+    /// @brief read-only list node with pointers to next and storage
+    struct staticnode
+    {
+        const NodeStorageType *sp; ///< pointer to storage
+        const staticnode *n;       ///< pointer to next list member or null
+    };
+
+    /// @brief the payloads are contiguous, so iteration uses plain pointers
+    typedef const NodeStorageType *iterator;
+
+    /// @brief builds the list from a braced list of payloads
+    /// @param values payloads in list order, e.g. `{{1, 2}, {3, 4}}`
+    constexpr staticlist(const NodeStorageType (&values)[Capacity])
+        : staticlist(typename makestaticindices<Capacity>::type(), values)
+    {
+    }
+
+    /// @brief copies the payloads and relinks the nodes to the new object
+    /// @param other list to copy
+    constexpr staticlist(const staticlist &other)
+        : staticlist(typename makestaticindices<Capacity>::type(), other.items)
+    {
+    }
+
+    staticlist &operator=(const staticlist &) = delete;
+
+    /// @brief gets the number of list members
+    /// @return Capacity
+    constexpr size_t size() const
+    {
+        return Capacity;
+    }
+
+    /// @brief gets the storage pointer at position
+    /// @param position 1-... position in the list
+    /// @return pointer to storage at position, or null if out of range
+    constexpr const NodeStorageType *getStoragePtr(int position) const
+    {
+        return (position < 1 || position > (int)Capacity) ? nullptr : &items[position - 1];
+    }
+
+    /// @brief gets the node at position
+    /// @param position 1-... position in the list
+    /// @return pointer to node at position, or null if out of range
+    constexpr const staticnode *getNode(int position) const
+    {
+        return (position < 1 || position > (int)Capacity) ? nullptr : &nodes[position - 1];
+    }
+
+    /// @brief appends a copy of every payload, in order, to a mutable list
+    /// @param list any list providing insertCopyAtEnd(const NodeStorageType &)
+    /// @return false if an insert failed (allocation failure)
+    template <typename MutableList>
+    bool copyInto(MutableList &list) const
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+        {
+            if (list.insertCopyAtEnd(items[i]) == nullptr)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @brief copies payloads into an array
+    /// @details the payloads are contiguous, so trivially copyable payloads are
+    /// copied with a single memcpy
+    /// @param out array of at least count constructed payloads
+    /// @param count maximum number of payloads to copy
+    /// @return number of payloads copied, min(count, Capacity)
+    size_t copyTo(NodeStorageType *out, size_t count) const
+    {
+        size_t copied = count < Capacity ? count : Capacity;
+        assign_payloads(out, items, copied);
+        return copied;
+    }
+
+    /// @brief first payload, for range-based for loops
+    constexpr const NodeStorageType *begin() const
+    {
+        return items;
+    }
+
+    /// @brief one past the last payload, for range-based for loops
+    constexpr const NodeStorageType *end() const
+    {
+        return items + Capacity;
+    }
+
+private:
+    template <size_t... Indices>
+    constexpr staticlist(staticindices<Indices...>, const NodeStorageType (&values)[Capacity])
+        : items{values[Indices]...},
+          nodes{staticnode{&items[Indices], Indices + 1 < Capacity ? &nodes[Indices + 1] : nullptr}...}
+    {
+    }
+
+    NodeStorageType items[Capacity]; ///< payloads in list order
+    staticnode nodes[Capacity];      ///< links over items
+};
+
+#endif // STATIC_LIST_H
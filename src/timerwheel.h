@@ -0,0 +1,243 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <Arduino.h>
+#include "circulardoublylinked.h"
+
+/// @brief function run when a timer expires
+typedef void (*timercallback)(void *context);
+
+/// @brief payload of a timer node
+struct timerentry
+{
+    uint32_t deadline;      ///< tick at which the timer fires
+    timercallback callback; ///< function to run, or null
+    void *context;          ///< argument passed to callback
+    uint16_t bucket;        ///< bucket the node is linked into
+};
+
+#ifdef ARDUINO
+/// @brief tick source running off millis(), one tick per millisecond
+struct millisclock
+{
+    uint32_t now() const
+    {
+        return millis();
+    }
+};
+#endif
+
+/// @brief hierarchical timer wheel with circulardoublylist buckets
+/// @details Level l has 2^SlotBits buckets, each spanning 2^(SlotBits * l) ticks.
+/// A timer is linked into the finest level that covers its remaining time and
+/// moves down a level ("cascades") each time the coarser bucket comes due, so
+/// every node is touched at most Levels times. Timers further out than the
+/// wheel spans wait in the top level and are re-placed until they are in range.
+///
+/// Timer nodes are preallocated in an idle bucket by the constructor; schedule,
+/// cancel, cascade and expiry only splice nodes between buckets, so they never
+/// allocate and are O(1) per timer.
+/// @tparam Clock tick source with `uint32_t now()`; ticks may wrap around
+/// @tparam Levels number of wheel levels
+/// @tparam SlotBits log2 of the buckets per level
+template <typename Clock, uint8_t Levels = 4, uint8_t SlotBits = 4>
+class timerwheel
+{
+public:
+    static_assert(Levels > 0 && SlotBits > 0 && Levels * SlotBits < 32, "wheel must span fewer than 2^32 ticks");
+    static_assert(SlotBits < 16 && Levels * (1UL << SlotBits) + 2U <= 65535U, "bucket ids, staging and idle included, must fit timerentry::bucket");
+
+    /// @brief bucket type, also the type of the idle pool
+    typedef circulardoublylist<timerentry> bucketlist;
+
+    /// @brief handle to a scheduled timer, valid until it fires or is cancelled
+    typedef typename bucketlist::circlynode *timerhandle;
+
+    /// @brief preallocates the timer nodes
+    /// @param tick_source clock the wheel follows
+    /// @param capacity maximum number of timers scheduled at once
+    timerwheel(Clock &tick_source, uint16_t capacity) : clock(tick_source), current(tick_source.now()), nodes(0U)
+    {
+        while (nodes < capacity)
+        {
+            timerhandle node = idle.insertAtEnd();
+            if (node == nullptr)
+            {
+                break; // allocation failure, the pool is smaller
+            }
+            node->sp->bucket = idle_bucket;
+            ++nodes;
+        }
+    }
+
+    timerwheel(const timerwheel &) = delete;
+    timerwheel &operator=(const timerwheel &) = delete;
+
+    /// @brief schedules callback to run delay ticks from now
+    /// @param delay ticks to wait; 0 is treated as 1, at most 2^31 - 1
+    /// @param callback function to run on expiry
+    /// @param context argument passed to callback
+    /// @return handle for cancel(), or null if every timer node is in use
+    timerhandle schedule(uint32_t delay, timercallback callback, void *context = nullptr)
+    {
+        if (idle.size() == 0)
+        {
+            return nullptr;
+        }
+        timerhandle node = idle.begin().node();
+        timerentry &entry = *node->sp;
+        entry.deadline = current + (delay > 0 ? delay : 1U);
+        entry.callback = callback;
+        entry.context = context;
+        place(node, idle);
+        return node;
+    }
+
+    /// @brief cancels a scheduled timer in O(1)
+    /// @param timer handle returned by schedule()
+    /// @return false if timer is null, already fired or already cancelled
+    bool cancel(timerhandle timer)
+    {
+        if (!isScheduled(timer))
+        {
+            return false;
+        }
+        release(timer);
+        return true;
+    }
+
+    /// @brief checks whether a handle still refers to a pending timer
+    /// @param timer handle returned by schedule()
+    /// @return true until the timer fires or is cancelled
+    bool isScheduled(timerhandle timer) const
+    {
+        return timer != nullptr && timer->sp->bucket != idle_bucket;
+    }
+
+    /// @brief runs every tick between the last poll and the clock's current tick
+    /// @details callbacks run from inside poll() and may schedule or cancel timers
+    /// @return number of timers that fired
+    uint16_t poll()
+    {
+        uint16_t fired = 0U;
+        uint32_t target = clock.now();
+        while (current != target)
+        {
+            fired += tick();
+        }
+        return fired;
+    }
+
+    /// @brief gets the number of pending timers
+    /// @return timers scheduled and not yet fired or cancelled
+    uint16_t pending() const
+    {
+        return nodes - (uint16_t)idle.size();
+    }
+
+    /// @brief gets the number of timers that can still be scheduled
+    /// @return free timer nodes
+    uint16_t available() const
+    {
+        return (uint16_t)idle.size();
+    }
+
+private:
+    static const uint16_t slots = 1U << SlotBits;                   ///< buckets per level
+    static const uint16_t slot_mask = slots - 1U;                   ///< bucket index mask
+    static const uint16_t staging_bucket = Levels * slots;          ///< bucket id of staging
+    static const uint16_t idle_bucket = staging_bucket + 1U;        ///< bucket id of idle
+    static const uint32_t span = 1UL << (Levels * SlotBits);        ///< ticks the wheel covers
+
+    /// @brief advances one tick: cascades coarser levels, then fires the due bucket
+    /// @return number of timers fired
+    uint16_t tick()
+    {
+        ++current;
+        if ((current & slot_mask) == 0U)
+        {
+            cascade(1U);
+        }
+        staging.spliceAllAtEnd(wheel[current & slot_mask]);
+        uint16_t fired = 0U;
+        for (timerentry &entry : staging)
+        {
+            entry.bucket = staging_bucket; // callbacks may cancel timers still in staging
+        }
+        while (staging.size() > 0)
+        {
+            timerhandle node = staging.begin().node();
+            timercallback callback = node->sp->callback;
+            void *context = node->sp->context;
+            release(node); // the node may be rescheduled by the callback
+            if (callback != nullptr)
+            {
+                callback(context);
+            }
+            ++fired;
+        }
+        return fired;
+    }
+
+    /// @brief re-places the timers of the level's current bucket one level down
+    /// @param level wheel level to cascade, 1-...
+    void cascade(uint8_t level)
+    {
+        if (level >= Levels)
+        {
+            return;
+        }
+        uint16_t index = (current >> (SlotBits * level)) & slot_mask;
+        staging.spliceAllAtEnd(wheel[level * slots + index]);
+        while (staging.size() > 0)
+        {
+            place(staging.begin().node(), staging);
+        }
+        if (index == 0U)
+        {
+            cascade(level + 1U);
+        }
+    }
+
+    /// @brief links a timer into the finest bucket that covers its deadline
+    /// @param node timer node
+    /// @param from list currently holding node
+    void place(timerhandle node, bucketlist &from)
+    {
+        timerentry &entry = *node->sp;
+        uint32_t remaining = entry.deadline - current;
+        uint32_t key = remaining < span ? entry.deadline : current + span - 1U;
+        uint8_t level = 0U;
+        while (level + 1U < Levels && (remaining >> (SlotBits * (level + 1U))) != 0U)
+        {
+            ++level;
+        }
+        uint16_t bucket = level * slots + ((key >> (SlotBits * level)) & slot_mask);
+        wheel[bucket].spliceAtEnd(node, from);
+        entry.bucket = bucket;
+    }
+
+    /// @brief returns a timer node to the idle pool
+    /// @param node pending timer node
+    void release(timerhandle node)
+    {
+        idle.spliceAtEnd(node, bucket_of(node->sp->bucket));
+        node->sp->bucket = idle_bucket;
+    }
+
+    /// @brief gets the list a bucket id refers to
+    /// @param bucket bucket id
+    bucketlist &bucket_of(uint16_t bucket)
+    {
+        return bucket == staging_bucket ? staging : bucket == idle_bucket ? idle : wheel[bucket];
+    }
+
+    Clock &clock;                     ///< tick source
+    uint32_t current;                 ///< last tick processed
+    uint16_t nodes;                   ///< timer nodes owned, idle or not
+    bucketlist wheel[Levels * slots]; ///< buckets, level by level
+    bucketlist staging;               ///< timers being cascaded or fired
+    bucketlist idle;                  ///< preallocated free timer nodes
+};
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,362 @@
+#ifndef TRACED_LIST_H
+#define TRACED_LIST_H
+
+#include <Arduino.h>
+
+/// @brief operation codes stored in a list trace
+enum traceop : uint8_t
+{
+    TRACE_INSERT_BEGINNING = 'B', ///< insertAtBeginning
+    TRACE_INSERT_END = 'E',       ///< insertAtEnd
+    TRACE_INSERT_POSITION = 'I',  ///< insertAtPosition, with position
+    TRACE_DELETE_POSITION = 'D',  ///< deleteFromPosition, with position
+    TRACE_GET_STORAGE = 'G',      ///< getStoragePtr, with position
+    TRACE_GET_NODE = 'N',         ///< getNode, with position
+    TRACE_REMOVE_BEGINNING = 'R', ///< removeAtBeginning
+    TRACE_CLEAR = 'C',            ///< clear
+    TRACE_INSERT_COPY_END = 'Y',  ///< insertCopyAtEnd
+    TRACE_INSERT_BOUNDED = 'W',   ///< insertAtEndBounded, with the bound
+    TRACE_DELETE_RANGE = 'X',     ///< deleteRange, with first and last position
+    TRACE_MATCH = 'M',            ///< node matched by the next removeIf / partition, or removed by the next unique, with its position
+    TRACE_REMOVE_IF = 'F',        ///< removeIf, after its matches
+    TRACE_PARTITION = 'P',        ///< partition, after its matches
+    TRACE_UNIQUE = 'U',           ///< unique, after its removals
+    TRACE_REVERSE = 'V',          ///< reverse
+    TRACE_FROM_ARRAY = 'A'        ///< fromArray, with the number of values
+};
+
+/// @brief one decoded trace record
+struct tracerecord
+{
+    traceop op;        ///< operation
+    uint32_t position; ///< 1-... position for positional operations, bound for W, count for A, else 0
+    uint32_t last;     ///< last position for deleteRange, else 0
+};
+
+/// @brief trace stream header: magic "TLT" and format version 2
+/// @details Version 2 added the opcodes from Y on; version 1 traces still decode.
+static const uint8_t trace_header[4] = {'T', 'L', 'T', 2};
+
+/// @brief checks whether an operation code carries a position
+/// @param op operation code
+/// @return true for positional operations
+inline bool trace_has_position(uint8_t op)
+{
+    return op == TRACE_INSERT_POSITION || op == TRACE_DELETE_POSITION || op == TRACE_GET_STORAGE || op == TRACE_GET_NODE ||
+           op == TRACE_INSERT_BOUNDED || op == TRACE_DELETE_RANGE || op == TRACE_MATCH || op == TRACE_FROM_ARRAY;
+}
+
+/// @brief checks whether an operation code carries a last position after its position
+/// @param op operation code
+/// @return true for deleteRange
+inline bool trace_has_last(uint8_t op)
+{
+    return op == TRACE_DELETE_RANGE;
+}
+
+/// @brief recording wrapper that logs every list operation to a byte sink
+/// @details Records are one opcode byte, followed for positional operations by
+/// the position as an unsigned LEB128 varint (one byte below 128), and for
+/// deleteRange by the last position too. Predicates are replaced by their
+/// outcome: removeIf, partition and unique first record one TRACE_MATCH per
+/// node they matched or removed, by its position before the call. The header
+/// is written before the first record. Payload arguments are not recorded.
+///
+/// List is a private base: operations that are not recorded (swap, splices,
+/// assignment) are not reachable, so a trace always replays the whole history.
+/// @tparam List singlylist, circulardoublylist or any basic_ variant
+/// @tparam Sink anything with `write(const uint8_t *, size_t)`, e.g. an Arduino
+/// Print such as Serial or an SD File
+template <typename List, typename Sink>
+class tracedlist : private List
+{
+public:
+    typedef typename List::size_type size_type; ///< node count and position type
+    typedef typename List::iterator iterator;   ///< forward iterator over the payloads
+
+    using List::begin;
+    using List::capacity;
+    using List::compact;
+    using List::copyTo;
+    using List::end;
+    using List::getLastAccessedNode;
+    using List::getLastAccessedNodeStoragePtr;
+    using List::memoryUsage;
+    using List::reserve;
+    using List::shrink_to_fit;
+    using List::size;
+    using List::toArray;
+
+    /// @param trace_sink destination of the trace bytes
+    tracedlist(Sink &trace_sink) : sink(trace_sink), header_written(false) {}
+
+    template <typename... Args>
+    auto insertAtBeginning(Args... args) -> decltype(List::insertAtBeginning(args...))
+    {
+        record(TRACE_INSERT_BEGINNING);
+        return List::insertAtBeginning(args...);
+    }
+
+    template <typename... Args>
+    auto insertAtEnd(Args... args) -> decltype(List::insertAtEnd(args...))
+    {
+        record(TRACE_INSERT_END);
+        return List::insertAtEnd(args...);
+    }
+
+    template <typename... Args>
+    auto insertAtPosition(size_type position, Args... args) -> decltype(List::insertAtPosition(position, args...))
+    {
+        record(TRACE_INSERT_POSITION, position);
+        return List::insertAtPosition(position, args...);
+    }
+
+    bool deleteFromPosition(size_type position)
+    {
+        record(TRACE_DELETE_POSITION, position);
+        return List::deleteFromPosition(position);
+    }
+
+    auto getStoragePtr(size_type position) -> decltype(List::getStoragePtr(position))
+    {
+        record(TRACE_GET_STORAGE, position);
+        return List::getStoragePtr(position);
+    }
+
+    template <typename Position>
+    auto getNode(Position position) -> decltype(List::getNode(position))
+    {
+        record(TRACE_GET_NODE, position);
+        return List::getNode(position);
+    }
+
+    template <typename L = List>
+    auto removeAtBeginning() -> decltype(static_cast<L *>(nullptr)->removeAtBeginning())
+    {
+        record(TRACE_REMOVE_BEGINNING);
+        return List::removeAtBeginning();
+    }
+
+    void clear()
+    {
+        record(TRACE_CLEAR);
+        List::clear();
+    }
+
+    template <typename Value>
+    auto insertCopyAtEnd(const Value &value) -> decltype(List::insertCopyAtEnd(value))
+    {
+        record(TRACE_INSERT_COPY_END);
+        return List::insertCopyAtEnd(value);
+    }
+
+    template <typename L = List, typename... Args>
+    auto insertAtEndBounded(size_type bound, Args... args) -> decltype(static_cast<L *>(nullptr)->insertAtEndBounded(bound, args...))
+    {
+        record(TRACE_INSERT_BOUNDED, bound);
+        return List::insertAtEndBounded(bound, args...);
+    }
+
+    bool deleteRange(size_type first, size_type last)
+    {
+        record(TRACE_DELETE_RANGE, first, last);
+        return List::deleteRange(first, last);
+    }
+
+    template <typename Predicate>
+    size_type removeIf(Predicate pred)
+    {
+        size_type removed = List::removeIf(matchrecorder<Predicate>(*this, pred, 0));
+        record(TRACE_REMOVE_IF);
+        return removed;
+    }
+
+    template <typename Predicate>
+    auto partition(Predicate pred) -> decltype(List::partition(pred))
+    {
+        auto back = List::partition(matchrecorder<Predicate>(*this, pred, 0));
+        record(TRACE_PARTITION);
+        return back;
+    }
+
+    template <typename Equal>
+    size_type unique(Equal eq)
+    {
+        size_type removed = List::unique(matchrecorder<Equal>(*this, eq, 1)); // call k judges node k + 1
+        record(TRACE_UNIQUE);
+        return removed;
+    }
+
+    void reverse()
+    {
+        record(TRACE_REVERSE);
+        List::reverse();
+    }
+
+    template <typename Value>
+    size_type fromArray(const Value *values, size_type count)
+    {
+        record(TRACE_FROM_ARRAY, count);
+        return List::fromArray(values, count);
+    }
+
+    template <typename L = List>
+    auto rbegin() -> decltype(static_cast<L *>(nullptr)->rbegin())
+    {
+        return List::rbegin();
+    }
+
+    template <typename L = List>
+    auto rend() -> decltype(static_cast<L *>(nullptr)->rend())
+    {
+        return List::rend();
+    }
+
+private:
+    /// @brief predicate wrapper recording a TRACE_MATCH for each node it matches
+    /// @details The lists call removeIf and partition predicates once per node
+    /// in list order, and unique's once per node after the head, so counting
+    /// calls gives each node's position before the call.
+    template <typename Predicate>
+    class matchrecorder
+    {
+    public:
+        matchrecorder(tracedlist &traced, Predicate wrapped, size_type before)
+            : owner(traced), pred(wrapped), position(before) {}
+
+        template <typename T>
+        bool operator()(T &payload)
+        {
+            return recorded(pred(payload));
+        }
+
+        template <typename T>
+        bool operator()(T &kept, T &candidate)
+        {
+            return recorded(pred(kept, candidate));
+        }
+
+    private:
+        bool recorded(bool matched)
+        {
+            ++position;
+            if (matched)
+            {
+                owner.record(TRACE_MATCH, position);
+            }
+            return matched;
+        }
+
+        tracedlist &owner;  ///< list whose trace gets the matches
+        Predicate pred;     ///< caller's predicate
+        size_type position; ///< position of the node judged by the last call
+    };
+
+    /// @brief appends value as an unsigned LEB128 varint
+    static void append_varint(uint8_t *bytes, uint8_t &length, uint32_t value)
+    {
+        do
+        {
+            uint8_t low = value & 0x7FU;
+            value >>= 7;
+            bytes[length++] = value ? (uint8_t)(low | 0x80U) : low;
+        } while (value);
+    }
+
+    /// @brief writes one record, preceded by the header the first time
+    /// @param op operation code
+    /// @param position position for positional operations
+    /// @param last last position for deleteRange
+    void record(traceop op, size_type position = 0, size_type last = 0)
+    {
+        if (!header_written)
+        {
+            sink.write(trace_header, sizeof(trace_header));
+            header_written = true;
+        }
+        uint8_t bytes[11];
+        uint8_t length = 0;
+        bytes[length++] = op;
+        if (trace_has_position(op))
+        {
+            append_varint(bytes, length, (uint32_t)position);
+        }
+        if (trace_has_last(op))
+        {
+            append_varint(bytes, length, (uint32_t)last);
+        }
+        sink.write(bytes, length);
+    }
+
+    Sink &sink;          ///< trace destination
+    bool header_written; ///< header emitted before the first record
+};
+
+/// @brief decodes a trace produced by tracedlist
+class tracereader
+{
+public:
+    /// @param trace_bytes whole trace, header included
+    /// @param trace_length number of bytes in the trace
+    tracereader(const uint8_t *trace_bytes, size_t trace_length)
+        : bytes(trace_bytes), length(trace_length), offset(sizeof(trace_header)),
+          valid(trace_length >= sizeof(trace_header) && memcmp(trace_bytes, trace_header, sizeof(trace_header) - 1) == 0 &&
+                trace_bytes[3] >= 1 && trace_bytes[3] <= trace_header[3])
+    {
+    }
+
+    /// @brief checks the trace header
+    /// @return true if the bytes start with a supported header, any version up to the current one
+    bool isValid() const
+    {
+        return valid;
+    }
+
+    /// @brief decodes the next record
+    /// @param out receives the record
+    /// @return false at the end of the trace or on a malformed record
+    bool next(tracerecord &out)
+    {
+        if (!valid || offset >= length)
+        {
+            return false;
+        }
+        out.op = (traceop)bytes[offset++];
+        out.position = 0;
+        out.last = 0;
+        if ((trace_has_position(out.op) && !read_varint(out.position)) ||
+            (trace_has_last(out.op) && !read_varint(out.last)))
+        {
+            valid = false;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    /// @brief decodes one unsigned LEB128 varint
+    /// @return false if the trace ends inside it or it overflows 32 bits
+    bool read_varint(uint32_t &value)
+    {
+        uint8_t shift = 0;
+        uint8_t byte;
+        do
+        {
+            if (offset >= length || shift > 28)
+            {
+                return false;
+            }
+            byte = bytes[offset++];
+            value |= (uint32_t)(byte & 0x7FU) << shift;
+            shift += 7;
+        } while (byte & 0x80U);
+        return true;
+    }
+
+    const uint8_t *bytes; ///< trace bytes
+    size_t length;        ///< trace length
+    size_t offset;        ///< read position
+    bool valid;           ///< header matched and no malformed record seen
+};
+
+#endif // TRACED_LIST_H
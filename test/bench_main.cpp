@@ -0,0 +1,1624 @@
+// TemplatedLinkedList benchmarks
+// Compile: g++ -std=c++11 -O2 -I../src -I. -o bench_bin bench_main.cpp
+// Or use the provided run_bench.ps1 / run_bench.sh scripts.
+// Run all benchmarks, or name the ones to run: ./bench_bin prefetch
+// TLL_BENCH_SCALE=<n> multiplies every workload size (default 1).
+// TLL_TRACE=<file> replays a trace recorded with tracedlist in the replay
+// benchmark; without it a synthetic trace is recorded and replayed.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <pthread.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TemplatedLinkedList.h"
+
+// ─── Minimal benchmark framework ──────────────────────────────────────────────
+
+typedef std::chrono::steady_clock bench_clock;
+
+static size_t g_scale = 1;
+
+static double elapsed_ms(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(bench_clock::now() - start).count();
+}
+
+static void report(const char *label, double ms, size_t ops)
+{
+    std::cout << "  " << std::left << std::setw(44) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms"
+              << std::setw(10) << std::setprecision(2) << (ms * 1e6 / (ops ? ops : 1)) << " ns/op\n";
+}
+
+// Counts heap allocations made by the lists under test
+static size_t g_heap_allocs = 0;
+
+// While a simulated MCU heap is installed (see the fragmentation benchmark)
+// every allocation comes from it instead of malloc, and like Arduino's new a
+// failed one returns null; run_bench.sh builds with -fcheck-new for that
+class simheap;
+static simheap *g_sim_heap = nullptr;
+static void *sim_allocate(size_t size);
+static bool sim_release(void *p);
+
+void *operator new(size_t size)
+{
+    ++g_heap_allocs;
+    if (g_sim_heap != nullptr)
+        return sim_allocate(size);
+    void *p = malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    if (g_sim_heap == nullptr || !sim_release(p))
+        free(p);
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void *p) noexcept
+{
+    operator delete(p);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+#endif
+
+// Nearest-rank percentile of an ascending-sorted sample
+template <typename T>
+static T percentile(const std::vector<T> &sorted, double pct)
+{
+    if (sorted.empty())
+        return T();
+    size_t rank = (size_t)(pct / 100.0 * (double)(sorted.size() - 1) + 0.5);
+    return sorted[rank];
+}
+
+// Keeps results observable so the optimizer cannot drop the measured work
+static volatile long g_sink = 0;
+
+struct Vec3
+{
+    int x, y, z;
+};
+
+// Rebuilds the back links of a relinked node sequence (no-op for singly nodes)
+template <typename Node>
+static void relink_back(std::vector<singlylistnode<Node> *> &) {}
+
+template <typename Node>
+static void relink_back(std::vector<circlylistnode<Node> *> &nodes)
+{
+    nodes.back()->n = nodes.front();
+    for (size_t i = 1; i < nodes.size(); i++)
+        nodes[i]->p = nodes[i - 1];
+    nodes.front()->p = nodes.back();
+}
+
+// Relinks the interior nodes of a list into a shuffled order so consecutive
+// list members sit far apart in memory, as they do after long churn.
+template <typename List>
+static void scatter_nodes(List &list)
+{
+    std::vector<decltype(list.begin().node())> nodes;
+    for (auto it = list.begin(); it != list.end(); ++it)
+        nodes.push_back(it.node());
+    if (nodes.size() < 4)
+        return;
+    std::mt19937 rng(12345);
+    std::shuffle(nodes.begin() + 1, nodes.end() - 1, rng); // head and tail stay put
+    for (size_t i = 0; i + 1 < nodes.size(); i++)
+        nodes[i]->n = nodes[i + 1];
+    relink_back(nodes);
+}
+
+// ─── prefetch ─────────────────────────────────────────────────────────────────
+
+template <typename List>
+static void bench_prefetch_list(const char *name, size_t count)
+{
+    List list;
+    for (size_t i = 0; i < count; i++)
+        list.insertAtEnd((int)i, 1, 2);
+    scatter_nodes(list);
+
+    std::string label(name);
+    auto start = bench_clock::now();
+    long sum = 0;
+    for (Vec3 &v : list)
+        sum += v.x + v.y;
+    g_sink = g_sink + sum;
+    report((label + " iterate").c_str(), elapsed_ms(start), count);
+
+    const int lookups = 8;
+    start = bench_clock::now();
+    for (int i = 1; i <= lookups; i++)
+        g_sink = g_sink + list.getStoragePtr((int)(count * i / (lookups + 1)))->x;
+    report((label + " getStoragePtr").c_str(), elapsed_ms(start), count * lookups / 2);
+
+    start = bench_clock::now();
+    list.clear();
+    report((label + " clear").c_str(), elapsed_ms(start), count);
+}
+
+static void bench_prefetch()
+{
+    const size_t count = 2000000 * g_scale;
+    std::cout << "  " << count << " scattered nodes per list\n";
+    bench_prefetch_list<singlylist<Vec3, int, int, int>>("singly   distance 0 ", count);
+    bench_prefetch_list<basic_singlylist<prefetchtraits<4>, Vec3, int, int, int>>("singly   distance 4 ", count);
+    bench_prefetch_list<basic_singlylist<prefetchtraits<16>, Vec3, int, int, int>>("singly   distance 16", count);
+    bench_prefetch_list<circulardoublylist<Vec3, int, int, int>>("circular distance 0 ", count);
+    bench_prefetch_list<basic_circulardoublylist<prefetchtraits<4>, Vec3, int, int, int>>("circular distance 4 ", count);
+    bench_prefetch_list<basic_circulardoublylist<prefetchtraits<16>, Vec3, int, int, int>>("circular distance 16", count);
+}
+
+// ─── replay ───────────────────────────────────────────────────────────────────
+
+struct VectorSink
+{
+    std::vector<uint8_t> bytes;
+    size_t write(const uint8_t *data, size_t count)
+    {
+        bytes.insert(bytes.end(), data, data + count);
+        return count;
+    }
+};
+
+static bool trace_every_64th(const Vec3 &v)
+{
+    return v.x % 64 == 0;
+}
+
+// Records a synthetic mix shaped like a lookup-heavy table: mostly positional
+// reads, with inserts and deletes at random positions around a steady size.
+static std::vector<uint8_t> synthetic_trace(size_t ops, int steady_size)
+{
+    VectorSink sink;
+    tracedlist<singlylist<Vec3, int, int, int>, VectorSink> list(sink);
+    std::mt19937 rng(2024);
+    for (int i = 0; i < steady_size; i++)
+        list.insertAtEnd(i, 0, 0);
+    for (size_t i = 0; i < ops; i++)
+    {
+        int size = list.size();
+        int roll = (int)(rng() % 100);
+        int position = 1 + (int)(rng() % (size + 1));
+        if (roll < 45 && size > 0)
+            list.getStoragePtr(position > size ? size : position);
+        else if (roll < 65 || size < steady_size / 2)
+            list.insertAtPosition(position, (int)i, 0, 0);
+        else if (roll < 75)
+            list.insertAtEnd((int)i, 0, 0);
+        else if (roll < 95)
+            list.deleteFromPosition(position > size ? size : position);
+        else if (roll < 98 || size < 4)
+            list.removeAtBeginning();
+        else if (roll < 99)
+            list.deleteRange(size - 3, size);
+        else if (i % 8 == 0)
+            list.removeIf(trace_every_64th);
+        else
+            list.insertCopyAtEnd(Vec3{(int)i, 0, 0});
+    }
+    list.reverse();
+    list.clear();
+    return sink.bytes;
+}
+
+static bool read_trace_file(const char *path, std::vector<uint8_t> &bytes)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+        return false;
+    uint8_t buffer[4096];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        bytes.insert(bytes.end(), buffer, buffer + got);
+    fclose(file);
+    return true;
+}
+
+// Lists without removeAtBeginning / a public getNode fall back to the
+// positional equivalent
+template <typename List>
+static auto replay_remove_front(List &list, int) -> decltype(list.removeAtBeginning())
+{
+    list.removeAtBeginning();
+}
+
+template <typename List>
+static void replay_remove_front(List &list, long)
+{
+    list.deleteFromPosition(1);
+}
+
+template <typename List>
+static auto replay_get_node(List &list, typename List::size_type position, int) -> decltype(list.getNode(position), void())
+{
+    g_sink = g_sink + (list.getNode(position) != nullptr);
+}
+
+template <typename List>
+static void replay_get_node(List &list, typename List::size_type position, long)
+{
+    g_sink = g_sink + (list.getStoragePtr(position) != nullptr);
+}
+
+// Lists without insertAtEndBounded drop the head first, as it would
+template <typename List>
+static auto replay_insert_bounded(List &list, typename List::size_type bound, int) -> decltype(list.insertAtEndBounded(bound, 0, 0, 0), void())
+{
+    list.insertAtEndBounded(bound, 0, 0, 0);
+}
+
+template <typename List>
+static void replay_insert_bounded(List &list, typename List::size_type bound, long)
+{
+    if (bound < 1)
+        return;
+    if (list.size() >= bound)
+        list.deleteFromPosition(1);
+    list.insertAtEnd(0, 0, 0);
+}
+
+// Stands in for a recorded predicate: matches the positions of the TRACE_MATCH
+// records before the operation, counting calls the way tracedlist did
+struct replaymatch
+{
+    const std::vector<uint32_t> *positions;
+    size_t next;
+    uint32_t position;
+
+    bool matched()
+    {
+        ++position;
+        if (next < positions->size() && (*positions)[next] == position)
+        {
+            ++next;
+            return true;
+        }
+        return false;
+    }
+    bool operator()(const Vec3 &) { return matched(); }
+    bool operator()(const Vec3 &, const Vec3 &) { return matched(); }
+};
+
+template <typename List>
+static void bench_replay_list(const char *name, const std::vector<tracerecord> &records)
+{
+    static const char op_names[] = "BEIDGNRCYWXFPUVA";
+    std::vector<std::vector<uint32_t>> latency(sizeof(op_names) - 1);
+    List list;
+    typedef typename List::size_type size_type;
+
+    size_t array_size = 0; // scratch space for fromArray and the matches, sized up front
+    size_t most_matches = 0;
+    size_t matches = 0;
+    for (const tracerecord &rec : records)
+    {
+        if (rec.op == TRACE_FROM_ARRAY && rec.position > array_size)
+            array_size = rec.position;
+        matches = rec.op == TRACE_MATCH ? matches + 1 : 0;
+        if (matches > most_matches)
+            most_matches = matches;
+    }
+    std::vector<Vec3> values(array_size, Vec3{0, 0, 0});
+    std::vector<uint32_t> matched;
+    matched.reserve(most_matches);
+    const Vec3 copy = {0, 0, 0};
+
+    size_t allocs_before = g_heap_allocs;
+    auto total_start = bench_clock::now();
+    for (const tracerecord &rec : records)
+    {
+        size_type position = (size_type)rec.position;
+        auto start = bench_clock::now();
+        switch (rec.op)
+        {
+        case TRACE_INSERT_BEGINNING: list.insertAtBeginning(0, 0, 0); break;
+        case TRACE_INSERT_END: list.insertAtEnd(0, 0, 0); break;
+        case TRACE_INSERT_POSITION: list.insertAtPosition(position, 0, 0, 0); break;
+        case TRACE_DELETE_POSITION: list.deleteFromPosition(position); break;
+        case TRACE_GET_STORAGE: g_sink = g_sink + (list.getStoragePtr(position) != nullptr); break;
+        case TRACE_GET_NODE: replay_get_node(list, position, 0); break;
+        case TRACE_REMOVE_BEGINNING: replay_remove_front(list, 0); break;
+        case TRACE_CLEAR: list.clear(); break;
+        case TRACE_INSERT_COPY_END: list.insertCopyAtEnd(copy); break;
+        case TRACE_INSERT_BOUNDED: replay_insert_bounded(list, position, 0); break;
+        case TRACE_DELETE_RANGE: list.deleteRange(position, (size_type)rec.last); break;
+        case TRACE_MATCH: matched.push_back(rec.position); break;
+        case TRACE_REMOVE_IF: list.removeIf(replaymatch{&matched, 0, 0}); matched.clear(); break;
+        case TRACE_PARTITION: list.partition(replaymatch{&matched, 0, 0}); matched.clear(); break;
+        case TRACE_UNIQUE: list.unique(replaymatch{&matched, 0, 1}); matched.clear(); break;
+        case TRACE_REVERSE: list.reverse(); break;
+        case TRACE_FROM_ARRAY: list.fromArray(values.data(), position); break;
+        }
+        uint32_t ns = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start).count();
+        const char *slot = strchr(op_names, rec.op);
+        if (slot != nullptr)
+            latency[slot - op_names].push_back(ns);
+    }
+    double total_ms = elapsed_ms(total_start);
+    size_t allocs = g_heap_allocs - allocs_before;
+
+    std::cout << "  " << name << ": " << std::fixed << std::setprecision(2) << total_ms << " ms total, "
+              << allocs << " allocations\n";
+    std::cout << "    op  count       p50 ns     p99 ns     max ns\n";
+    for (size_t i = 0; i < latency.size(); i++)
+    {
+        std::vector<uint32_t> &sample = latency[i];
+        if (sample.empty())
+            continue;
+        std::sort(sample.begin(), sample.end());
+        std::cout << "    " << op_names[i] << std::setw(8) << sample.size()
+                  << std::setw(13) << percentile(sample, 50.0)
+                  << std::setw(11) << percentile(sample, 99.0)
+                  << std::setw(11) << sample.back() << "\n";
+    }
+}
+
+static void bench_replay()
+{
+    std::vector<uint8_t> bytes;
+    const char *path = getenv("TLL_TRACE");
+    if (path != nullptr)
+    {
+        if (!read_trace_file(path, bytes))
+        {
+            std::cerr << "  cannot read trace " << path << "\n";
+            return;
+        }
+        std::cout << "  trace " << path << "\n";
+    }
+    else
+    {
+        bytes = synthetic_trace(100000 * g_scale, 2000);
+        std::cout << "  synthetic trace\n";
+    }
+
+    tracereader reader(bytes.data(), bytes.size());
+    std::vector<tracerecord> records;
+    tracerecord rec;
+    while (reader.next(rec))
+        records.push_back(rec);
+    if (!reader.isValid())
+    {
+        std::cerr << "  malformed trace after " << records.size() << " records\n";
+        return;
+    }
+    std::cout << "  " << records.size() << " operations, " << bytes.size() << " bytes\n";
+
+    bench_replay_list<singlylist<Vec3, int, int, int>>("singlylist", records);
+    bench_replay_list<circulardoublylist<Vec3, int, int, int>>("circulardoublylist", records);
+    bench_replay_list<basic_singlylist<inlinetraits<16>, Vec3, int, int, int>>("singlylist, 16 inline nodes", records);
+    bench_replay_list<basic_circulardoublylist<prefetchtraits<8>, Vec3, int, int, int>>("circulardoublylist, prefetch 8", records);
+}
+
+// ─── reserve ──────────────────────────────────────────────────────────────────
+
+// Calls reserve() only where the list type supports it, so one benchmark body
+// serves lists with and without spare slots
+template <bool Reserved>
+struct reservestep
+{
+    template <typename List>
+    static void apply(List &list, size_t count) { list.reserve((typename List::size_type)count); }
+};
+
+template <>
+struct reservestep<false>
+{
+    template <typename List>
+    static void apply(List &, size_t) {}
+};
+
+// Times each insertAtEnd into a list that churns around `count` nodes and
+// prints a log2 latency histogram
+template <typename List, bool Reserved>
+static void bench_reserve_list(const char *name, size_t count)
+{
+    List list;
+    reservestep<Reserved>::apply(list, count);
+    for (size_t i = 0; i < count / 2; i++) // half full, with room to churn into
+        list.insertAtEnd(0, 0, 0);
+
+    std::vector<uint32_t> sample;
+    sample.reserve(count * 4);
+    size_t allocs_before = g_heap_allocs;
+    for (size_t round = 0; round < 4; round++)
+    {
+        for (size_t i = (size_t)list.size(); i < count; i++)
+        {
+            auto start = bench_clock::now();
+            list.insertAtEnd((int)i, 0, 0);
+            sample.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(bench_clock::now() - start).count());
+        }
+        while ((size_t)list.size() > count / 2)
+            list.deleteFromPosition(1);
+    }
+    size_t allocs = g_heap_allocs - allocs_before;
+
+    size_t buckets[32] = {};
+    for (uint32_t ns : sample)
+    {
+        size_t bucket = 0;
+        while ((ns >> bucket) > 1 && bucket < 31)
+            ++bucket;
+        ++buckets[bucket];
+    }
+    std::sort(sample.begin(), sample.end());
+    std::cout << "  " << name << (Reserved ? ", reserved" : "") << ": " << sample.size() << " inserts, "
+              << allocs << " allocations, p50 " << percentile(sample, 50.0) << " ns, p99 "
+              << percentile(sample, 99.0) << " ns, p99.9 " << percentile(sample, 99.9) << " ns, max "
+              << sample.back() << " ns\n";
+    for (size_t bucket = 0; bucket < 32; bucket++)
+    {
+        if (buckets[bucket] == 0)
+            continue;
+        std::cout << "    < " << std::setw(9) << (2ULL << bucket) << " ns " << std::setw(9) << buckets[bucket] << "\n";
+    }
+}
+
+static void bench_reserve()
+{
+    size_t count = 50000 * g_scale;
+    bench_reserve_list<singlylist<Vec3, int, int, int>, false>("singlylist", count);
+    bench_reserve_list<basic_singlylist<reservetraits, Vec3, int, int, int>, true>("singlylist", count);
+    bench_reserve_list<circulardoublylist<Vec3, int, int, int>, false>("circulardoublylist", count);
+    bench_reserve_list<basic_circulardoublylist<reservetraits, Vec3, int, int, int>, true>("circulardoublylist", count);
+}
+
+// ─── export ───────────────────────────────────────────────────────────────────
+
+template <typename List>
+static void bench_export_list(const char *name, size_t count, size_t repeats)
+{
+    std::vector<Vec3> source(count);
+    for (size_t i = 0; i < count; i++)
+        source[i] = Vec3{(int)i, 1, 2};
+    std::vector<Vec3> out(count);
+    List list;
+    list.fromArray(source.data(), (typename List::size_type)count);
+    size_t bytes = count * sizeof(Vec3) * repeats;
+    std::cout << "  " << name << ", " << count << " nodes\n";
+
+    auto start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+        for (size_t i = 0; i < count; i++)
+            out[i] = *list.getStoragePtr((typename List::size_type)(i + 1));
+    double ms = elapsed_ms(start);
+    g_sink = g_sink + out[count - 1].x;
+    std::cout << "    getStoragePtr loop  " << std::setw(9) << std::fixed << std::setprecision(2) << ms << " ms  "
+              << std::setw(8) << bytes / 1048576.0 / (ms / 1000.0) << " MiB/s\n";
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        size_t i = 0;
+        for (Vec3 &v : list)
+            out[i++] = v;
+    }
+    ms = elapsed_ms(start);
+    g_sink = g_sink + out[count - 1].x;
+    std::cout << "    iterator loop       " << std::setw(9) << ms << " ms  "
+              << std::setw(8) << bytes / 1048576.0 / (ms / 1000.0) << " MiB/s\n";
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+        list.copyTo(out.data(), (typename List::size_type)count);
+    ms = elapsed_ms(start);
+    g_sink = g_sink + out[count - 1].x;
+    std::cout << "    copyTo              " << std::setw(9) << ms << " ms  "
+              << std::setw(8) << bytes / 1048576.0 / (ms / 1000.0) << " MiB/s\n";
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        List fresh;
+        for (size_t i = 0; i < count; i++)
+            fresh.insertCopyAtEnd(source[i]);
+        g_sink = g_sink + fresh.size();
+    }
+    ms = elapsed_ms(start);
+    std::cout << "    insertCopyAtEnd loop" << std::setw(9) << ms << " ms  "
+              << std::setw(8) << bytes / 1048576.0 / (ms / 1000.0) << " MiB/s (build + free)\n";
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        List fresh;
+        fresh.fromArray(source.data(), (typename List::size_type)count);
+        g_sink = g_sink + fresh.size();
+    }
+    ms = elapsed_ms(start);
+    std::cout << "    fromArray           " << std::setw(9) << ms << " ms  "
+              << std::setw(8) << bytes / 1048576.0 / (ms / 1000.0) << " MiB/s (build + free)\n";
+}
+
+static void bench_export()
+{
+    size_t count = 4000 * g_scale;
+    bench_export_list<singlylist<Vec3, int, int, int>>("singlylist", count, 20);
+    bench_export_list<circulardoublylist<Vec3, int, int, int>>("circulardoublylist", count, 20);
+}
+
+// ─── rcu ──────────────────────────────────────────────────────────────────────
+
+// Readers walk and sum a list while one writer replaces a node every few
+// microseconds. rculist readers take no lock; the baseline guards a
+// circulardoublylist with a pthread reader-writer lock.
+typedef basic_rculist<Vec3, 16, int, int, int> rcu_bench_list;
+
+struct rwlocked_list
+{
+    rwlocked_list()
+    {
+        pthread_rwlockattr_t attr;
+        pthread_rwlockattr_init(&attr);
+#ifdef __GLIBC__
+        // the default prefers readers, which starves the writer outright
+        pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+        pthread_rwlock_init(&lock, &attr);
+        pthread_rwlockattr_destroy(&attr);
+    }
+    ~rwlocked_list() { pthread_rwlock_destroy(&lock); }
+    pthread_rwlock_t lock;
+    circulardoublylist<Vec3, int, int, int> list;
+};
+
+// Per-thread reader of the rwlock baseline, shaped like rculist's reader
+struct rwlocked_reader
+{
+    explicit rwlocked_reader(rwlocked_list &shared) : locked(shared) {}
+    rwlocked_list &locked;
+};
+
+static long rcu_walk(rcu_bench_list::reader &self)
+{
+    rcu_bench_list::readguard guard(self);
+    long sum = 0;
+    for (const Vec3 &v : self)
+        sum += v.x;
+    return sum;
+}
+
+static long rcu_walk(rwlocked_reader &self)
+{
+    pthread_rwlock_rdlock(&self.locked.lock);
+    long sum = 0;
+    for (Vec3 &v : self.locked.list)
+        sum += v.x;
+    pthread_rwlock_unlock(&self.locked.lock);
+    return sum;
+}
+
+static void rcu_replace(rcu_bench_list &list, int x)
+{
+    list.removeAtBeginning();
+    list.insertAtEnd(x, 1, 2);
+}
+
+static void rcu_replace(rwlocked_list &shared, int x)
+{
+    pthread_rwlock_wrlock(&shared.lock);
+    shared.list.deleteFromPosition(1);
+    shared.list.insertAtEnd(x, 1, 2);
+    pthread_rwlock_unlock(&shared.lock);
+}
+
+// Runs `threads` readers for `ms` milliseconds and returns total walks/s
+template <typename Reader, typename Shared>
+static double rcu_run(Shared &shared, int threads, double ms)
+{
+    std::atomic<bool> stop(false);
+    std::vector<size_t> walks(threads, 0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < threads; t++)
+        readers.emplace_back([&shared, &stop, &walks, t]() {
+            Reader self(shared);
+            size_t done = 0;
+            long sum = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                sum += rcu_walk(self);
+                ++done;
+            }
+            walks[t] = done;
+            g_sink = g_sink + sum;
+        });
+    auto start = bench_clock::now();
+    int x = 0;
+    while (elapsed_ms(start) < ms)
+    {
+        rcu_replace(shared, x++);
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+    stop.store(true);
+    for (std::thread &reader : readers)
+        reader.join();
+    double seconds = elapsed_ms(start) / 1000.0;
+    size_t total = 0;
+    for (size_t w : walks)
+        total += w;
+    return total / seconds;
+}
+
+static void bench_rcu()
+{
+    const size_t count = 1000;
+    const double ms = 200.0 * g_scale;
+    std::cout << "  " << count << " nodes, one writer replacing a node every ~20 us, "
+              << "list walks/s summed over all readers\n";
+    std::cout << "  " << std::setw(8) << "readers" << std::setw(14) << "rculist" << std::setw(14) << "rwlock"
+              << std::setw(10) << "ratio" << "\n";
+    const int thread_counts[] = {1, 2, 4, 8, 16};
+    for (int threads : thread_counts)
+    {
+        rcu_bench_list rcu;
+        rwlocked_list locked;
+        for (size_t i = 0; i < count; i++)
+        {
+            rcu.insertAtEnd((int)i, 1, 2);
+            locked.list.insertAtEnd((int)i, 1, 2);
+        }
+        double rcu_rate = rcu_run<rcu_bench_list::reader>(rcu, threads, ms);
+        double lock_rate = rcu_run<rwlocked_reader>(locked, threads, ms);
+        std::cout << "  " << std::setw(8) << threads << std::setw(14) << std::fixed << std::setprecision(0) << rcu_rate
+                  << std::setw(14) << lock_rate << std::setw(9) << std::setprecision(2) << rcu_rate / lock_rate << "x\n";
+    }
+}
+
+// ─── simd ─────────────────────────────────────────────────────────────────────
+
+// Full-list find (of an absent value), threshold count, min and sum over
+// sensor-style samples: a per-node loop over a singlylist, the same loop over
+// a chunkedlist's iterator, and the chunkedlist kernels.
+#if defined(__AVX2__)
+static const char *g_simd_isa = "AVX2";
+#elif defined(__SSE2__)
+static const char *g_simd_isa = "SSE2";
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+static const char *g_simd_isa = "NEON";
+#else
+static const char *g_simd_isa = "scalar";
+#endif
+
+template <typename List, typename T>
+static void bench_simd_loops(const char *label, List &list, size_t count, size_t repeats)
+{
+    T absent = (T)-1;
+    auto start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        size_t at = 0;
+        for (const T &x : list)
+        {
+            if (x == absent)
+                break;
+            ++at;
+        }
+        g_sink = g_sink + (long)at;
+    }
+    double find_ms = elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        size_t matched = 0;
+        for (const T &x : list)
+            matched += x > (T)50 ? 1 : 0;
+        g_sink = g_sink + (long)matched;
+    }
+    double count_ms = elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        T best = *list.begin();
+        for (const T &x : list)
+            best = x < best ? x : best;
+        g_sink = g_sink + (long)best;
+    }
+    double min_ms = elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        typename simdsum<T>::type total = 0;
+        for (const T &x : list)
+            total += x;
+        g_sink = g_sink + (long)total;
+    }
+    double sum_ms = elapsed_ms(start);
+
+    double scale = 1e6 / (double)(count * repeats);
+    std::cout << "    " << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << find_ms * scale << std::setw(9) << count_ms * scale
+              << std::setw(9) << min_ms * scale << std::setw(9) << sum_ms * scale << "\n";
+}
+
+template <typename T>
+static void bench_simd_kernels(const chunkedlist<T> &list, size_t count, size_t repeats)
+{
+    auto start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+        g_sink = g_sink + (list.find((T)-1) != nullptr);
+    double find_ms = elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+        g_sink = g_sink + (long)list.countIf(THRESHOLD_GREATER, (T)50);
+    double count_ms = elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+    {
+        T best;
+        list.min(best);
+        g_sink = g_sink + (long)best;
+    }
+    double min_ms = elapsed_ms(start);
+
+    start = bench_clock::now();
+    for (size_t r = 0; r < repeats; r++)
+        g_sink = g_sink + (long)list.sum();
+    double sum_ms = elapsed_ms(start);
+
+    double scale = 1e6 / (double)(count * repeats);
+    std::cout << "    " << std::left << std::setw(22) << "chunkedlist kernels" << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << find_ms * scale << std::setw(9) << count_ms * scale
+              << std::setw(9) << min_ms * scale << std::setw(9) << sum_ms * scale << "\n";
+}
+
+template <typename T>
+static void bench_simd_type(const char *name, size_t count, size_t repeats)
+{
+    std::mt19937 rng(11);
+    singlylist<T, T> nodes;
+    chunkedlist<T> chunks;
+    for (size_t i = 0; i < count; i++)
+    {
+        T sample = (T)(rng() % 100); // never the absent value -1
+        nodes.insertAtEnd(sample);
+        chunks.insertAtEnd(sample);
+    }
+    std::cout << "  " << name << ", " << count << " samples (ns per sample)\n";
+    std::cout << "    " << std::left << std::setw(22) << "" << std::right
+              << std::setw(9) << "find" << std::setw(9) << "count>" << std::setw(9) << "min" << std::setw(9) << "sum" << "\n";
+    bench_simd_loops<singlylist<T, T>, T>("singlylist loop", nodes, count, repeats);
+    bench_simd_loops<chunkedlist<T>, T>("chunkedlist loop", chunks, count, repeats);
+    bench_simd_kernels<T>(chunks, count, repeats);
+}
+
+static void bench_simd()
+{
+    size_t count = 100000 * g_scale;
+    std::cout << "  kernels built for " << g_simd_isa << "\n";
+    bench_simd_type<int32_t>("int32_t", count, 20);
+    bench_simd_type<int16_t>("int16_t", count, 20);
+    bench_simd_type<float>("float", count, 20);
+}
+
+// ─── footprint ────────────────────────────────────────────────────────────────
+
+// Prices each node layout on three ABIs by laying out its fields from
+// per-ABI sizes and alignments, so one host run covers every target. The
+// LP64 model is checked against this build's sizeof and memoryUsage().
+enum fieldkind
+{
+    FIELD_CHAR,
+    FIELD_UINT16,
+    FIELD_INT,
+    FIELD_LONG,
+    FIELD_FLOAT,
+    FIELD_DOUBLE,
+    FIELD_PTR,
+    FIELD_SIZE,
+    FIELD_KINDS
+};
+
+struct abimodel
+{
+    const char *name;
+    size_t size[FIELD_KINDS];  // by fieldkind
+    size_t align[FIELD_KINDS]; // by fieldkind
+    size_t heap_header;        // allocator bytes before each block
+    size_t heap_align;         // blocks are rounded up to this
+    size_t heap_min;           // smallest block, header included
+};
+
+static const abimodel g_abis[] = {
+    {"LP64 (64-bit hosts)", {1, 2, 4, 8, 4, 8, 8, 8}, {1, 2, 4, 8, 4, 8, 8, 8}, 8, 16, 32},
+    {"ILP32 (Cortex-M, ESP32)", {1, 2, 4, 4, 4, 8, 4, 4}, {1, 2, 4, 4, 4, 8, 4, 4}, 4, 8, 16},
+    {"AVR (16-bit pointers)", {1, 2, 2, 4, 4, 4, 2, 2}, {1, 1, 1, 1, 1, 1, 1, 1}, 2, 1, 4},
+};
+
+struct payloadmodel
+{
+    const char *name;
+    fieldkind fields[4];
+    size_t count;
+    bool arithmetic; // chunkedlist applies
+};
+
+static const payloadmodel g_payloads[] = {
+    {"uint8_t", {FIELD_CHAR}, 1, true},
+    {"int", {FIELD_INT}, 1, true},
+    {"float", {FIELD_FLOAT}, 1, true},
+    {"double", {FIELD_DOUBLE}, 1, true},
+    {"Vec3 {int x3}", {FIELD_INT, FIELD_INT, FIELD_INT}, 3, false},
+    {"Container {int x4}", {FIELD_INT, FIELD_INT, FIELD_INT, FIELD_INT}, 4, false},
+    {"Reading {long, float, u8}", {FIELD_LONG, FIELD_FLOAT, FIELD_CHAR}, 3, false},
+};
+
+// Lays out struct members in declaration order with C alignment rules
+class layoutmodel
+{
+public:
+    explicit layoutmodel(const abimodel &target) : abi(target), bytes(0), alignment(1) {}
+    layoutmodel &add(size_t size, size_t align)
+    {
+        bytes = (bytes + align - 1) / align * align + size;
+        alignment = std::max(alignment, align);
+        return *this;
+    }
+    layoutmodel &field(fieldkind kind) { return add(abi.size[kind], abi.align[kind]); }
+    layoutmodel &payload(const payloadmodel &p, size_t repeat = 1)
+    {
+        layoutmodel inner(abi);
+        for (size_t i = 0; i < p.count; i++)
+            inner.field(p.fields[i]);
+        return add(inner.size() * repeat, inner.align());
+    }
+    size_t size() const { return (bytes + alignment - 1) / alignment * alignment; }
+    size_t align() const { return alignment; }
+
+private:
+    const abimodel &abi;
+    size_t bytes;
+    size_t alignment;
+};
+
+// Bytes one heap allocation of `bytes` really takes under the ABI's allocator
+static size_t modelled_block(const abimodel &abi, size_t bytes)
+{
+    size_t block = (bytes + abi.heap_header + abi.heap_align - 1) / abi.heap_align * abi.heap_align;
+    return std::max(block, abi.heap_min);
+}
+
+static size_t modelled_list_object(const abimodel &abi)
+{
+    // head, tail, lastnode, list_nodes; the default traits keep no spare slots
+    return layoutmodel(abi).field(FIELD_PTR).field(FIELD_PTR).field(FIELD_PTR).field(FIELD_INT).size();
+}
+
+static void bench_footprint()
+{
+    const size_t chunk = 32;
+    std::cout << "  bytes per element with every node on the heap (allocator overhead included);\n"
+              << "  inline = a node slot embedded in the list object; intrusive = payload plus\n"
+              << "  one next pointer in one allocation; chunked = chunkedlist<T, 32>, full chunks\n";
+    for (const abimodel &abi : g_abis)
+    {
+        std::cout << "\n  " << abi.name << "\n";
+        std::cout << "    " << std::left << std::setw(26) << "payload" << std::right << std::setw(8) << "sizeof"
+                  << std::setw(9) << "singly" << std::setw(9) << "circular" << std::setw(9) << "inline"
+                  << std::setw(10) << "intrusive" << std::setw(9) << "chunked" << std::setw(9) << "static" << "\n";
+        for (const payloadmodel &p : g_payloads)
+        {
+            size_t payload = layoutmodel(abi).payload(p).size();
+            size_t singly = layoutmodel(abi).field(FIELD_PTR).field(FIELD_PTR).payload(p).size();
+            size_t circular = layoutmodel(abi).field(FIELD_PTR).field(FIELD_PTR).field(FIELD_PTR).payload(p).size();
+            size_t intrusive = layoutmodel(abi).payload(p).field(FIELD_PTR).size();
+            size_t chunknode = layoutmodel(abi).payload(p, chunk).field(FIELD_UINT16).field(FIELD_UINT16).field(FIELD_PTR).size();
+            std::cout << "    " << std::left << std::setw(26) << p.name << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(8) << (double)payload
+                      << std::setw(9) << (double)modelled_block(abi, singly)
+                      << std::setw(9) << (double)modelled_block(abi, circular)
+                      << std::setw(9) << (double)singly
+                      << std::setw(10) << (double)modelled_block(abi, intrusive);
+            if (p.arithmetic)
+                std::cout << std::setw(9) << (double)modelled_block(abi, chunknode) / chunk;
+            else
+                std::cout << std::setw(9) << "-";
+            std::cout << std::setw(9) << (double)(payload + 2 * abi.size[FIELD_PTR]) << "\n";
+        }
+        size_t chunked_object = layoutmodel(abi).field(FIELD_PTR).field(FIELD_PTR).field(FIELD_SIZE).field(FIELD_SIZE).size();
+        std::cout << "    list object: singlylist / circulardoublylist " << modelled_list_object(abi)
+                  << " bytes, chunkedlist " << chunked_object << " bytes, plus inline slots\n";
+    }
+
+    if (sizeof(void *) == 8 && sizeof(long) == 8)
+    {
+        const abimodel &lp64 = g_abis[0];
+        const payloadmodel &vec3 = g_payloads[4];
+        singlylist<Vec3, int, int, int> singly;
+        circulardoublylist<Vec3, int, int, int> circular;
+        for (int i = 0; i < 1000; i++)
+        {
+            singly.insertAtEnd(i, 0, 0);
+            circular.insertAtEnd(i, 0, 0);
+        }
+        std::cout << "\n  host check, Vec3 (LP64 model vs this build)\n";
+        std::cout << "    singly slot      modelled " << layoutmodel(lp64).field(FIELD_PTR).field(FIELD_PTR).payload(vec3).size()
+                  << ", sizeof " << sizeof(nodeslot<singlylistnode<Vec3>, Vec3>) << "\n";
+        std::cout << "    circular slot    modelled " << layoutmodel(lp64).field(FIELD_PTR).field(FIELD_PTR).field(FIELD_PTR).payload(vec3).size()
+                  << ", sizeof " << sizeof(nodeslot<circlylistnode<Vec3>, Vec3>) << "\n";
+        std::cout << "    list object      modelled " << modelled_list_object(lp64) << ", sizeof " << sizeof(singly) << "\n";
+        std::cout << "    1000-node lists  memoryUsage().total() / 1000: singly "
+                  << std::setprecision(1) << singly.memoryUsage().total() / 1000.0
+                  << ", circular " << circular.memoryUsage().total() / 1000.0 << "\n";
+    }
+}
+
+// ─── churn ────────────────────────────────────────────────────────────────────
+
+// Event-queue churn: `live` nodes stay queued while insertAtEnd /
+// deleteFromPosition(1) pairs run through. With `busy_heap` every pair also
+// replaces one block in a ring of unrelated allocations, as other code
+// sharing the heap would.
+template <typename List>
+static void bench_churn_list(const char *name, size_t live, size_t pairs, bool busy_heap)
+{
+    List list;
+    for (size_t i = 0; i < live; i++)
+        list.insertAtEnd((int)i, 0, 0);
+    std::vector<char *> ring(256, nullptr);
+
+    size_t allocs_before = g_heap_allocs;
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < pairs; i++)
+    {
+        list.insertAtEnd((int)i, 0, 0);
+        if (busy_heap)
+        {
+            char *&block = ring[i % ring.size()];
+            delete[] block;
+            block = new char[24 + (i * 7) % 72];
+        }
+        list.deleteFromPosition(1);
+    }
+    double ms = elapsed_ms(start);
+    size_t allocs = g_heap_allocs - allocs_before - (busy_heap ? pairs : 0);
+    for (char *block : ring)
+        delete[] block;
+    g_sink = g_sink + list.getStoragePtr(1)->x;
+
+    char label[96];
+    snprintf(label, sizeof(label), "%s, %s", name, busy_heap ? "busy heap" : "quiet heap");
+    report(label, ms, pairs);
+    std::cout << "    " << std::fixed << std::setprecision(3) << (double)allocs / (double)pairs
+              << " list allocations per pair\n";
+}
+
+static void bench_churn()
+{
+    size_t pairs = 2000000 * g_scale;
+    const size_t lives[] = {64, 4096, 65536};
+    for (size_t live : lives)
+    {
+        std::cout << "  " << live << " nodes queued, " << pairs << " insert/remove pairs\n";
+        for (int busy = 0; busy < 2; busy++)
+        {
+            bench_churn_list<singlylist<Vec3, int, int, int>>("singlylist, new/delete", live, pairs, busy != 0);
+            bench_churn_list<basic_singlylist<slabtraits<32>, Vec3, int, int, int>>("singlylist, slabs of 32+", live, pairs, busy != 0);
+            bench_churn_list<circulardoublylist<Vec3, int, int, int>>("circulardoublylist, new/delete", live, pairs, busy != 0);
+            bench_churn_list<basic_circulardoublylist<slabtraits<32>, Vec3, int, int, int>>("circulardoublylist, slabs of 32+", live, pairs, busy != 0);
+        }
+    }
+}
+
+// ─── window ───────────────────────────────────────────────────────────────────
+
+// Keeps the last `window` readings of a circulardoublylist: either an
+// insertAtEnd / deleteFromPosition(1) pair per reading, or one
+// insertAtEndBounded() that overwrites the head once the window is full
+template <typename List>
+static void bench_window_list(const char *name, size_t window, size_t readings, bool bounded)
+{
+    List list;
+    for (size_t i = 0; i < window; i++)
+        list.insertAtEnd((int)i, 0, 0);
+
+    size_t allocs_before = g_heap_allocs;
+    auto start = bench_clock::now();
+    if (bounded)
+    {
+        for (size_t i = 0; i < readings; i++)
+            list.insertAtEndBounded((int)window, (int)i, 0, 0);
+    }
+    else
+    {
+        for (size_t i = 0; i < readings; i++)
+        {
+            list.insertAtEnd((int)i, 0, 0);
+            list.deleteFromPosition(1);
+        }
+    }
+    double ms = elapsed_ms(start);
+    size_t allocs = g_heap_allocs - allocs_before;
+    g_sink = g_sink + list.getStoragePtr(1)->x;
+
+    char label[96];
+    snprintf(label, sizeof(label), "%s, %s", name, bounded ? "insertAtEndBounded" : "insert + delete");
+    report(label, ms, readings);
+    std::cout << "    " << std::fixed << std::setprecision(3) << (double)allocs / (double)readings
+              << " allocations per reading\n";
+}
+
+static void bench_window()
+{
+    size_t readings = 4000000 * g_scale;
+    const size_t windows[] = {16, 1024, 65536};
+    for (size_t window : windows)
+    {
+        std::cout << "  window of " << window << ", " << readings << " readings\n";
+        for (int bounded = 0; bounded < 2; bounded++)
+        {
+            bench_window_list<circulardoublylist<Vec3, int, int, int>>("new/delete", window, readings, bounded != 0);
+            bench_window_list<basic_circulardoublylist<slabtraits<32>, Vec3, int, int, int>>("slabs of 32+", window, readings, bounded != 0);
+        }
+    }
+}
+
+// ─── compact ──────────────────────────────────────────────────────────────────
+
+template <typename List>
+static long scan_list(List &list)
+{
+    long sum = 0;
+    for (Vec3 &v : list)
+        sum += v.x + v.y;
+    return sum;
+}
+
+// Scans a slab list relinked into random heap order, compacts it and scans
+// it again; `fresh` is a list built in order on a fresh heap, for reference
+template <typename List, typename Fresh>
+static void bench_compact_list(const char *name, size_t count)
+{
+    const size_t passes = 4;
+    std::string label(name);
+    {
+        Fresh fresh;
+        for (size_t i = 0; i < count; i++)
+            fresh.insertAtEnd((int)i, 1, 2);
+        auto start = bench_clock::now();
+        for (size_t pass = 0; pass < passes; pass++)
+            g_sink = g_sink + scan_list(fresh);
+        report((label + " new/delete, built in order").c_str(), elapsed_ms(start), count * passes);
+    }
+
+    List list;
+    for (size_t i = 0; i < count; i++)
+        list.insertAtEnd((int)i, 1, 2);
+    scatter_nodes(list);
+    auto start = bench_clock::now();
+    for (size_t pass = 0; pass < passes; pass++)
+        g_sink = g_sink + scan_list(list);
+    report((label + " slabs, scattered").c_str(), elapsed_ms(start), count * passes);
+
+    size_t allocs_before = g_heap_allocs;
+    start = bench_clock::now();
+    bool compacted = list.compact();
+    double ms = elapsed_ms(start);
+    size_t allocs = g_heap_allocs - allocs_before;
+    report((label + " compact()").c_str(), ms, count);
+
+    start = bench_clock::now();
+    for (size_t pass = 0; pass < passes; pass++)
+        g_sink = g_sink + scan_list(list);
+    report((label + " slabs, compacted").c_str(), elapsed_ms(start), count * passes);
+    std::cout << "    compact() " << (compacted ? "succeeded" : "FAILED") << " with " << allocs << " allocation(s)\n";
+}
+
+static void bench_compact()
+{
+    const size_t counts[] = {16384, 2000000 * g_scale};
+    for (size_t count : counts)
+    {
+        std::cout << "  " << count << " nodes, scanned " << 4 << " times\n";
+        bench_compact_list<basic_singlylist<slabtraits<32>, Vec3, int, int, int>, singlylist<Vec3, int, int, int>>("singlylist", count);
+        bench_compact_list<basic_circulardoublylist<slabtraits<32>, Vec3, int, int, int>, circulardoublylist<Vec3, int, int, int>>("circulardoublylist", count);
+    }
+}
+
+// ─── bloom ────────────────────────────────────────────────────────────────────
+
+// Linear contains() on a plain list, as a caller without a filter writes it
+template <typename List>
+static bool walk_contains(List &list, int key)
+{
+    for (int &v : list)
+        if (v == key)
+            return true;
+    return false;
+}
+
+// Miss-heavy contains() queries against `count` keys (even numbers), with
+// and without a counting Bloom filter of Counters counters
+template <size_t Counters>
+static void bench_bloom_list(size_t count, size_t queries, double plain_ns)
+{
+    const uint8_t probes = 3;
+    bloomlist<singlylist<int, int>, listkey<int>, Counters, probes> list;
+    for (size_t i = 0; i < count; i++)
+        list.insertAtEnd((int)i * 2);
+
+    size_t passed = 0;
+    for (size_t i = 0; i < queries; i++)
+        passed += list.mayContain((int)(i * 2 + 1)) ? 1 : 0;
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < queries; i++)
+        g_sink = g_sink + list.contains((int)(i * 2 + 1));
+    double ms = elapsed_ms(start);
+
+    double fill = 1.0 - std::exp(-(double)probes * (double)count / (double)Counters);
+    char label[96];
+    snprintf(label, sizeof(label), "bloomlist, %zu counters (%zu per node)", Counters, Counters / count);
+    report(label, ms, queries);
+    std::cout << "    false positives " << std::fixed << std::setprecision(2) << 100.0 * passed / queries
+              << " % (predicted " << 100.0 * fill * fill * fill << " %), filter " << Counters / 2
+              << " bytes, " << std::setprecision(0) << plain_ns / (ms * 1e6 / queries) << "x faster misses\n";
+}
+
+// Insert / delete churn cost of keeping the filter up to date
+template <typename List>
+static void bench_bloom_churn(const char *name, size_t count, size_t pairs)
+{
+    List list;
+    for (size_t i = 0; i < count; i++)
+        list.insertAtEnd((int)i);
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < pairs; i++)
+    {
+        list.insertAtEnd((int)(count + i));
+        list.removeAtBeginning();
+    }
+    report(name, elapsed_ms(start), pairs);
+}
+
+template <size_t Count>
+static void bench_bloom_size(size_t queries)
+{
+    singlylist<int, int> plain;
+    for (size_t i = 0; i < Count; i++)
+        plain.insertAtEnd((int)i * 2);
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < queries; i++)
+        g_sink = g_sink + walk_contains(plain, (int)(i * 2 + 1));
+    double ms = elapsed_ms(start);
+    report("singlylist, linear walk", ms, queries);
+    double plain_ns = ms * 1e6 / queries;
+    bench_bloom_list<Count * 4>(Count, queries, plain_ns);
+    bench_bloom_list<Count * 8>(Count, queries, plain_ns);
+    bench_bloom_list<Count * 16>(Count, queries, plain_ns);
+}
+
+static void bench_bloom()
+{
+    const size_t queries = 20000 * g_scale;
+    std::cout << "  " << queries << " contains() queries for absent keys, 3 probes\n";
+    std::cout << "  1024 nodes\n";
+    bench_bloom_size<1024>(queries);
+    std::cout << "  16384 nodes\n";
+    bench_bloom_size<16384>(queries / 4);
+
+    const size_t pairs = 1000000 * g_scale;
+    std::cout << "  " << pairs << " insertAtEnd / removeAtBeginning pairs, 1024 nodes queued\n";
+    bench_bloom_churn<singlylist<int, int>>("singlylist", 1024, pairs);
+    bench_bloom_churn<bloomlist<singlylist<int, int>, listkey<int>, 8192>>("bloomlist, 8192 counters", 1024, pairs);
+}
+
+// ─── fragmentation ────────────────────────────────────────────────────────────
+
+// Deterministic model of a small MCU heap, after the malloc in avr-libc
+// (AVR Arduinos) or newlib-nano (Cortex-M Arduinos). Chunks carry a size
+// header and are carved from the top of the heap break; freed chunks go on
+// an address-ordered free list and merge with free neighbours, and a free
+// chunk at the break lowers it. avr-libc takes an exact fit, else the
+// smallest fit; newlib-nano takes the first fit. Both split a chunk when the
+// rest can hold a free-list entry, handing out its upper end.
+//
+// Sizes are host sizes: headers, pointers and the 8-byte granule are four
+// times their AVR counterparts, so arenas are scaled by sizeof(void *) / 2
+// to keep a node's share of the heap close to the board's.
+class simheap
+{
+public:
+    enum policy
+    {
+        AVR_LIBC,   ///< exact fit, else best fit
+        NEWLIB_NANO ///< first fit
+    };
+
+    simheap(size_t bytes, policy fit) : arena(bytes), brk(nullptr), free_list(nullptr), rule(fit)
+    {
+        brk = arena.data();
+    }
+
+    void *allocate(size_t size)
+    {
+        size_t need = (size + header + granule - 1) / granule * granule;
+        if (need < sizeof(chunk))
+            need = sizeof(chunk);
+        chunk **best = nullptr;
+        for (chunk **at = &free_list; *at != nullptr; at = &(*at)->next)
+        {
+            size_t have = (*at)->size;
+            if (have < need)
+                continue;
+            if (rule == NEWLIB_NANO || have == need)
+            {
+                best = at;
+                break;
+            }
+            if (best == nullptr || have < (*best)->size)
+                best = at;
+        }
+        if (best != nullptr)
+        {
+            chunk *found = *best;
+            if (found->size - need >= sizeof(chunk))
+            {
+                found->size -= need; // split, handing out the upper end
+                chunk *taken = reinterpret_cast<chunk *>(reinterpret_cast<unsigned char *>(found) + found->size);
+                taken->size = need;
+                return reinterpret_cast<unsigned char *>(taken) + header;
+            }
+            *best = found->next;
+            return reinterpret_cast<unsigned char *>(found) + header;
+        }
+        if ((size_t)(arena.data() + arena.size() - brk) < need)
+            return nullptr;
+        chunk *fresh = reinterpret_cast<chunk *>(brk);
+        fresh->size = need;
+        brk += need;
+        return reinterpret_cast<unsigned char *>(fresh) + header;
+    }
+
+    // Returns false if p is not from this heap
+    bool release(void *p)
+    {
+        unsigned char *bytes = static_cast<unsigned char *>(p);
+        if (bytes < arena.data() || bytes >= arena.data() + arena.size())
+            return false;
+        chunk *freed = reinterpret_cast<chunk *>(bytes - header);
+        chunk *before = nullptr;
+        chunk *after = free_list;
+        while (after != nullptr && after < freed)
+        {
+            before = after;
+            after = after->next;
+        }
+        freed->next = after;
+        if (after != nullptr && end_of(freed) == reinterpret_cast<unsigned char *>(after))
+        {
+            freed->size += after->size;
+            freed->next = after->next;
+        }
+        if (before != nullptr && end_of(before) == reinterpret_cast<unsigned char *>(freed))
+        {
+            before->size += freed->size;
+            before->next = freed->next;
+            freed = before;
+        }
+        else if (before != nullptr)
+            before->next = freed;
+        else
+            free_list = freed;
+        if (end_of(freed) == brk) // the top chunk goes back to the break
+        {
+            brk = reinterpret_cast<unsigned char *>(freed);
+            if (before != nullptr && before != freed)
+                before->next = nullptr;
+            else if (before == freed)
+                unlink_last();
+            else
+                free_list = nullptr;
+        }
+        return true;
+    }
+
+    // Bytes that could still be handed out, headers not counted
+    size_t free_bytes() const
+    {
+        size_t total = top();
+        for (const chunk *c = free_list; c != nullptr; c = c->next)
+            total += c->size - header;
+        return total;
+    }
+
+    // Largest single allocation that would still succeed
+    size_t largest_free() const
+    {
+        size_t largest = top();
+        for (const chunk *c = free_list; c != nullptr; c = c->next)
+            largest = std::max(largest, c->size - header);
+        return largest;
+    }
+
+private:
+    struct chunk
+    {
+        size_t size; // whole chunk, header included
+        chunk *next; // next free chunk by address; payload bytes while allocated
+    };
+    static const size_t header = sizeof(size_t);
+    static const size_t granule = 8;
+
+    static unsigned char *end_of(chunk *c)
+    {
+        return reinterpret_cast<unsigned char *>(c) + c->size;
+    }
+
+    size_t top() const
+    {
+        size_t room = (size_t)(arena.data() + arena.size() - brk);
+        return room > header ? room - header : 0;
+    }
+
+    void unlink_last()
+    {
+        chunk **at = &free_list;
+        while ((*at)->next != nullptr)
+            at = &(*at)->next;
+        *at = nullptr;
+    }
+
+    std::vector<unsigned char> arena;
+    unsigned char *brk;
+    chunk *free_list;
+    policy rule;
+};
+
+static void *sim_allocate(size_t size)
+{
+    return g_sim_heap->allocate(size);
+}
+
+static bool sim_release(void *p)
+{
+    return g_sim_heap->release(p);
+}
+
+// Model of the layout before nodeslot: node and payload are two allocations
+struct splitlist
+{
+    struct splitnode
+    {
+        Vec3 *sp;
+        splitnode *n;
+    };
+    splitnode *head = nullptr;
+    splitnode *tail = nullptr;
+    int count = 0;
+
+    ~splitlist()
+    {
+        while (count > 0)
+            deleteFromPosition(1);
+    }
+    splitnode *insertAtEnd(int x, int y, int z)
+    {
+        splitnode *node = new splitnode{nullptr, nullptr};
+        if (node == nullptr)
+            return nullptr;
+        node->sp = new Vec3{x, y, z};
+        if (node->sp == nullptr)
+        {
+            delete node;
+            return nullptr;
+        }
+        (tail != nullptr ? tail->n : head) = node;
+        tail = node;
+        ++count;
+        return node;
+    }
+    bool deleteFromPosition(int position)
+    {
+        splitnode **at = &head;
+        splitnode *previous = nullptr;
+        for (int i = 1; i < position; i++)
+        {
+            previous = *at;
+            at = &(*at)->n;
+        }
+        splitnode *node = *at;
+        *at = node->n;
+        if (node == tail)
+            tail = previous;
+        delete node->sp;
+        delete node;
+        --count;
+        return true;
+    }
+    int size() const { return count; }
+};
+
+struct fragresult
+{
+    size_t failed_at;       // step of the first failed allocation, 0 if none
+    bool list_failed;       // the list's allocation failed rather than another block
+    int nodes;              // nodes in the list at the end
+    size_t free_bytes;      // at the end
+    size_t largest;         // largest free block at the end
+    size_t worst_largest;   // smallest "largest free block" seen during the run
+};
+
+// Random insert/delete workload on one list while other code keeps a ring of
+// string-like blocks (10-120 bytes) alive. The list object itself lives on the
+// simulated heap, so inline slots are paid for too. Runs until the first
+// failed allocation or `steps` steps.
+template <typename List, bool Reserved>
+static fragresult run_fragmentation(simheap &heap, int cap, size_t steps, unsigned seed)
+{
+    fragresult result = {0, false, 0, 0, 0, (size_t)-1};
+    std::mt19937 rng(seed);
+    void *ring[24] = {};
+    g_sim_heap = &heap;
+    {
+        List *list = new List();
+        reservestep<Reserved>::apply(*list, (size_t)cap);
+        for (size_t step = 1; step <= steps && result.failed_at == 0; step++)
+        {
+            unsigned roll = rng() % 100;
+            if (roll < 15)
+            {
+                void *&slot = ring[rng() % 24];
+                operator delete(slot);
+                slot = heap.allocate(10 + rng() % 111);
+                if (slot == nullptr)
+                    result.failed_at = step;
+            }
+            else if ((roll < 60 && list->size() < cap) || list->size() == 0)
+            {
+                if (list->insertAtEnd((int)step, 0, 0) == nullptr)
+                {
+                    result.failed_at = step;
+                    result.list_failed = true;
+                }
+            }
+            else
+                list->deleteFromPosition(1 + (int)(rng() % (unsigned)list->size()));
+            result.worst_largest = std::min(result.worst_largest, heap.largest_free());
+        }
+        result.nodes = list->size();
+        result.free_bytes = heap.free_bytes();
+        result.largest = heap.largest_free();
+        delete list;
+        for (void *slot : ring)
+            operator delete(slot);
+    }
+    g_sim_heap = nullptr;
+    return result;
+}
+
+template <typename List, bool Reserved = false>
+static void bench_fragmentation_list(const char *name, size_t arena, simheap::policy fit, int cap, size_t steps)
+{
+    simheap heap(arena, fit);
+    fragresult r = run_fragmentation<List, Reserved>(heap, cap, steps, 2024);
+    double ratio = r.free_bytes > 0 ? 1.0 - (double)r.largest / (double)r.free_bytes : 0.0;
+    std::cout << "    " << std::left << std::setw(34) << name << std::right;
+    if (r.failed_at != 0)
+        std::cout << std::setw(9) << r.failed_at << (r.list_failed ? " list " : " other");
+    else
+        std::cout << std::setw(9) << "none" << "      ";
+    std::cout << std::setw(7) << r.nodes << std::setw(8) << r.free_bytes << std::setw(9) << r.largest
+              << std::setw(8) << std::fixed << std::setprecision(2) << ratio << std::setw(10) << r.worst_largest << "\n";
+}
+
+static void bench_fragmentation()
+{
+    const size_t steps = 200000 * g_scale;
+    const size_t scale = sizeof(void *) / 2;
+    const size_t boards[] = {2048, 8192};
+    const simheap::policy fits[] = {simheap::AVR_LIBC, simheap::NEWLIB_NANO};
+    typedef nodeslot<singlylistnode<Vec3>, Vec3> slot;
+    std::cout << "  random inserts / deletes (list capped at about 60% of the heap) plus a ring of\n"
+              << "  24 blocks of 10-120 bytes, until the first failed allocation or " << steps << " steps;\n"
+              << "  arenas are board RAM x" << scale << " (host / AVR pointer size)\n";
+    for (size_t board : boards)
+    {
+        for (simheap::policy fit : fits)
+        {
+            size_t arena = board * scale;
+            int cap = (int)(arena * 3 / 5 / (sizeof(slot) + sizeof(size_t)));
+            std::cout << "\n  " << board / 1024 << " KB board, " << (fit == simheap::AVR_LIBC ? "avr-libc" : "newlib-nano")
+                      << " malloc, " << arena << "-byte arena, up to " << cap << " nodes\n";
+            std::cout << "    " << std::left << std::setw(34) << "layout" << std::right << std::setw(15) << "first failure"
+                      << std::setw(7) << "nodes" << std::setw(8) << "free" << std::setw(9) << "largest"
+                      << std::setw(8) << "frag" << std::setw(10) << "worst lg" << "\n";
+            bench_fragmentation_list<splitlist>("node + payload (2 allocations)", arena, fit, cap, steps);
+            bench_fragmentation_list<singlylist<Vec3, int, int, int>>("singlylist (nodeslot)", arena, fit, cap, steps);
+            bench_fragmentation_list<basic_singlylist<reservetraits, Vec3, int, int, int>, true>("singlylist, reserve(cap)", arena, fit, cap, steps);
+            bench_fragmentation_list<basic_singlylist<slabtraits<8>, Vec3, int, int, int>>("singlylist, slabs of 8+", arena, fit, cap, steps);
+            bench_fragmentation_list<basic_singlylist<inlinetraits<16>, Vec3, int, int, int>>("singlylist, 16 inline nodes", arena, fit, cap, steps);
+        }
+    }
+}
+
+// ─── main ─────────────────────────────────────────────────────────────────────
+
+struct benchmark
+{
+    const char *name;
+    void (*run)();
+};
+
+static const benchmark g_benchmarks[] = {
+    {"prefetch", bench_prefetch},
+    {"replay", bench_replay},
+    {"reserve", bench_reserve},
+    {"export", bench_export},
+    {"rcu", bench_rcu},
+    {"simd", bench_simd},
+    {"footprint", bench_footprint},
+    {"churn", bench_churn},
+    {"window", bench_window},
+    {"compact", bench_compact},
+    {"bloom", bench_bloom},
+    {"fragmentation", bench_fragmentation},
+};
+
+int main(int argc, char **argv)
+{
+    const char *scale = getenv("TLL_BENCH_SCALE");
+    if (scale != nullptr && atoi(scale) > 0)
+        g_scale = (size_t)atoi(scale);
+
+    std::cout << "TemplatedLinkedList benchmarks\n";
+    std::cout << "==============================\n";
+
+    int ran = 0;
+    for (const benchmark &b : g_benchmarks)
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc; i++)
+            selected = selected || strcmp(argv[i], b.name) == 0;
+        if (!selected)
+            continue;
+        std::cout << "\n[" << b.name << "]\n";
+        b.run();
+        ++ran;
+    }
+    if (ran == 0)
+    {
+        std::cerr << "No benchmark matched. Available:";
+        for (const benchmark &b : g_benchmarks)
+            std::cerr << " " << b.name;
+        std::cerr << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -59,36 +59,48 @@ if ($Clean -and (Test-Path $OutBin)) {
     Write-Host "Removed existing binary."
 }
 
-# ─── Compile ─────────────────────────────────────────────────────────────────
-Write-Host "Compiling $TestSrc ..."
-
-& $Gpp `
-    -std=c++11 -Wall -Wextra -Wpedantic `
-    -I"$LibSrc" `
-    -I"$ScriptDir" `
-    -o "$OutBin" `
-    "$TestSrc"
-
-if ($LASTEXITCODE -ne 0) {
-    Write-Error "Compilation failed (exit $LASTEXITCODE)."
-    exit 1
+# ─── Compile and run ─────────────────────────────────────────────────────────
+# The suite runs as C++11 (the library's baseline) and, if the compiler
+# supports it, again as C++20, which adds the listchannel coroutine tests.
+$Standards = @("c++11")
+"" | & $Gpp -std=c++20 -x c++ -fsyntax-only - 2>$null | Out-Null
+if ($LASTEXITCODE -eq 0) {
+    $Standards += "c++20"
 }
 
-Write-Host "Compilation succeeded.`n"
+$ExitCode = 0
+foreach ($Std in $Standards) {
+    Write-Host "Compiling $TestSrc (-std=$Std) ..."
 
-# ─── Run ─────────────────────────────────────────────────────────────────────
-Write-Host "Running tests ..."
-Write-Host ""
+    & $Gpp `
+        -std=$Std -Wall -Wextra -Wpedantic -pthread `
+        -I"$LibSrc" `
+        -I"$ScriptDir" `
+        -o "$OutBin" `
+        "$TestSrc"
+
+    if ($LASTEXITCODE -ne 0) {
+        Write-Error "Compilation failed (exit $LASTEXITCODE)."
+        exit 1
+    }
+
+    Write-Host "Compilation succeeded.`n"
 
-& "$OutBin"
-$ExitCode = $LASTEXITCODE
+    Write-Host "Running tests (-std=$Std) ..."
+    Write-Host ""
+
+    & "$OutBin"
+    if ($LASTEXITCODE -ne 0) {
+        $ExitCode = $LASTEXITCODE
+    }
+    Write-Host ""
+}
 
 # ─── Cleanup ─────────────────────────────────────────────────────────────────
 if (Test-Path $OutBin) {
     Remove-Item -Force $OutBin
 }
 
-Write-Host ""
 if ($ExitCode -eq 0) {
     Write-Host "Result: PASSED" -ForegroundColor Green
 } else {
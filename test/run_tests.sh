@@ -39,34 +39,42 @@ if [[ $CLEAN -eq 1 && -f "$OUT_BIN" ]]; then
     echo "Removed existing binary."
 fi
 
-# ─── Compile ─────────────────────────────────────────────────────────────────
-echo "Compiling $TEST_SRC ..."
-
-if ! "$GXX" \
-        -std=c++11 -Wall -Wextra -Wpedantic \
-        -I"$LIB_SRC" \
-        -I"$SCRIPT_DIR" \
-        -o "$OUT_BIN" \
-        "$TEST_SRC"; then
-    echo ""
-    echo "Error: compilation failed." >&2
-    exit 1
+# ─── Compile and run ─────────────────────────────────────────────────────────
+# The suite runs as C++11 (the library's baseline) and, if the compiler
+# supports it, again as C++20, which adds the listchannel coroutine tests.
+STANDARDS=(c++11)
+if echo "" | "$GXX" -std=c++20 -x c++ -fsyntax-only - >/dev/null 2>&1; then
+    STANDARDS+=(c++20)
 fi
 
-echo "Compilation succeeded."
-echo ""
+EXIT_CODE=0
+for STD in "${STANDARDS[@]}"; do
+    echo "Compiling $TEST_SRC (-std=$STD) ..."
 
-# ─── Run ─────────────────────────────────────────────────────────────────────
-echo "Running tests ..."
-echo ""
+    if ! "$GXX" \
+            -std="$STD" -Wall -Wextra -Wpedantic -pthread \
+            -I"$LIB_SRC" \
+            -I"$SCRIPT_DIR" \
+            -o "$OUT_BIN" \
+            "$TEST_SRC"; then
+        echo ""
+        echo "Error: compilation failed." >&2
+        exit 1
+    fi
 
-"$OUT_BIN"
-EXIT_CODE=$?
+    echo "Compilation succeeded."
+    echo ""
+
+    echo "Running tests (-std=$STD) ..."
+    echo ""
+
+    "$OUT_BIN" || EXIT_CODE=$?
+    echo ""
+done
 
 # ─── Cleanup ─────────────────────────────────────────────────────────────────
 rm -f "$OUT_BIN"
 
-echo ""
 if [[ $EXIT_CODE -eq 0 ]]; then
     echo "Result: PASSED"
 else
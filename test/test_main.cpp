@@ -4,8 +4,51 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <initializer_list>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
 #include "TemplatedLinkedList.h"
 
+// ─── Heap allocation counter ──────────────────────────────────────────────────
+
+static size_t g_heap_allocs = 0;
+
+void *operator new(size_t size)
+{
+    ++g_heap_allocs;
+    void *p = malloc(size ? size : 1);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    free(p);
+}
+
 // ─── Minimal test framework ───────────────────────────────────────────────────
 
 static int g_run    = 0;
@@ -279,6 +322,19 @@ void test_singly_last_accessed()
     // Updated by insertAtPosition
     auto *n3 = list.insertAtPosition(2, 7, 8, 9);
     CHECK(list.getLastAccessedNode()           == n3);
+
+    // Cleared when the head it points at is deleted
+    list.getStoragePtr(1);
+    CHECK(list.deleteFromPosition(1)           == true);
+    CHECK(list.getLastAccessedNode()           == nullptr);
+    CHECK(list.getLastAccessedNodeStoragePtr() == nullptr);
+    list.getNode(1);
+    list.removeAtBeginning();
+    CHECK(list.getLastAccessedNode()           == nullptr);
+    CHECK(list.size()                          == 1);
+    list.removeAtBeginning();
+    CHECK(list.size()                          == 0);
+    CHECK(list.insertAtEnd(1, 0, 0)            == list.getNode(1)); // tail was reset too
 }
 
 void test_singly_clear()
@@ -661,6 +717,2308 @@ void test_cdl_destructor()
     CHECK(true); // reaching here == no crash
 }
 
+// ─── staticlist tests ─────────────────────────────────────────────────────────
+
+static constexpr staticlist<Vec3, 3> k_static_vecs{{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}};
+
+// Built entirely at compile time
+static_assert(k_static_vecs.size() == 3, "staticlist size");
+static_assert(k_static_vecs.getStoragePtr(2)->y == 5, "staticlist getStoragePtr");
+static_assert(k_static_vecs.getStoragePtr(0) == nullptr, "staticlist lower bound");
+static_assert(k_static_vecs.getStoragePtr(4) == nullptr, "staticlist upper bound");
+static_assert(k_static_vecs.getNode(1)->n->n->sp->z == 9, "staticlist links");
+static_assert(k_static_vecs.getNode(3)->n == nullptr, "staticlist tail");
+
+void test_static_access()
+{
+    begin_suite("staticlist: getNode / getStoragePtr / iteration");
+
+    for (int i = 1; i <= 3; i++)
+    {
+        const Vec3 *sp = k_static_vecs.getStoragePtr(i);
+        CHECK(sp                              != nullptr);
+        CHECK(sp->x                           == 3 * i - 2);
+        CHECK(k_static_vecs.getNode(i)->sp    == sp);
+    }
+    CHECK(k_static_vecs.getStoragePtr(-1) == nullptr);
+    CHECK(k_static_vecs.getNode(0)        == nullptr);
+    CHECK(k_static_vecs.getNode(4)        == nullptr);
+
+    // Node walk and range-for visit the same payloads in order
+    int sum = 0;
+    for (const auto *node = k_static_vecs.getNode(1); node != nullptr; node = node->n)
+        sum += node->sp->x;
+    CHECK(sum == 12);
+    sum = 0;
+    for (const Vec3 &v : k_static_vecs)
+        sum += v.x;
+    CHECK(sum == 12);
+
+    // A copy relinks to its own payloads
+    staticlist<Vec3, 3> copy(k_static_vecs);
+    CHECK(copy.getNode(1)->sp      == copy.getStoragePtr(1));
+    CHECK(copy.getNode(1)->n->sp   == copy.getStoragePtr(2));
+    CHECK(copy.getStoragePtr(3)->z == 9);
+}
+
+void test_static_copy_into()
+{
+    begin_suite("staticlist: copyInto mutable lists");
+
+    singlylist<Vec3, int, int, int> list;
+    list.insertAtEnd(0, 0, 0);
+    CHECK(k_static_vecs.copyInto(list) == true);
+    CHECK(list.getStoragePtr(1)->x     == 0);
+    CHECK(list.getStoragePtr(2)->x     == 1);
+    CHECK(list.getStoragePtr(4)->z     == 9);
+    CHECK(list.getStoragePtr(5)        == nullptr);
+    // Copies are independent of the read-only source
+    CHECK(list.getStoragePtr(2)        != k_static_vecs.getStoragePtr(1));
+    list.getStoragePtr(2)->x = 100;
+    CHECK(k_static_vecs.getStoragePtr(1)->x == 1);
+
+    circulardoublylist<Vec3, int, int, int> dlist;
+    CHECK(k_static_vecs.copyInto(dlist) == true);
+    CHECK(dlist.getStoragePtr(1)->x     == 1);
+    CHECK(dlist.getStoragePtr(3)->x     == 7);
+    CHECK(dlist.getStoragePtr(4)        == nullptr);
+}
+
+// ─── small-buffer (inline node) tests ─────────────────────────────────────────
+
+template <typename List, typename Node>
+static bool node_is_inline(const List &list, const Node *node)
+{
+    const char *lo = reinterpret_cast<const char *>(&list);
+    const char *at = reinterpret_cast<const char *>(node);
+    return at >= lo && at < lo + sizeof(List);
+}
+
+void test_singly_inline_nodes()
+{
+    begin_suite("singlylist: inline node slots");
+    basic_singlylist<inlinetraits<4>, Vec3, int, int, int> list;
+
+    size_t before = g_heap_allocs;
+    for (int i = 1; i <= 4; i++)
+        CHECK(node_is_inline(list, list.insertAtEnd(i, 0, 0)));
+    CHECK(g_heap_allocs == before); // small list never allocates
+
+    // Overflow goes to the heap, one allocation per node + payload
+    auto *spill = list.insertAtEnd(5, 0, 0);
+    CHECK(!node_is_inline(list, spill));
+    CHECK(g_heap_allocs == before + 1);
+    for (int i = 1; i <= 5; i++)
+        CHECK(list.getStoragePtr(i)->x == i);
+
+    // Freed inline slots are reused before the heap
+    CHECK(list.deleteFromPosition(2) == true);
+    before = g_heap_allocs;
+    CHECK(node_is_inline(list, list.insertAtBeginning(0, 0, 0)));
+    CHECK(g_heap_allocs == before);
+    CHECK(list.getStoragePtr(1)->x == 0);
+    CHECK(list.getStoragePtr(2)->x == 1);
+    CHECK(list.getStoragePtr(3)->x == 3);
+
+    // clear() relinks inline slots; refilling does not allocate
+    list.clear();
+    before = g_heap_allocs;
+    for (int i = 1; i <= 4; i++)
+        list.insertAtPosition(i, i, 0, 0);
+    CHECK(g_heap_allocs == before);
+    CHECK(list.getStoragePtr(4)->x == 4);
+    CHECK(list.getStoragePtr(5) == nullptr);
+}
+
+void test_cdl_inline_nodes()
+{
+    begin_suite("circulardoublylist: inline node slots");
+    basic_circulardoublylist<inlinetraits<3>, Vec3, int, int, int> list;
+
+    size_t before = g_heap_allocs;
+    auto *n1 = list.insertAtEnd(1, 0, 0);
+    auto *n2 = list.insertAtBeginning(0, 0, 0);
+    auto *n3 = list.insertAtPosition(2, 9, 0, 0);
+    CHECK(node_is_inline(list, n1));
+    CHECK(node_is_inline(list, n2));
+    CHECK(node_is_inline(list, n3));
+    CHECK(g_heap_allocs == before);
+    CHECK(n2->n == n3);
+    CHECK(n3->n == n1);
+    CHECK(n1->n == n2);
+    CHECK(n2->p == n1);
+
+    auto *spill = list.insertAtEnd(2, 0, 0);
+    CHECK(!node_is_inline(list, spill));
+    CHECK(g_heap_allocs == before + 1);
+
+    CHECK(list.deleteFromPosition(1) == true);
+    before = g_heap_allocs;
+    CHECK(list.insertAtEnd(3, 0, 0) == n2); // freed inline slot reused
+    CHECK(g_heap_allocs == before);
+    CHECK(list.getStoragePtr(1)->x == 9);
+    CHECK(list.getStoragePtr(4)->x == 3);
+
+    list.clear();
+    CHECK(list.getStoragePtr(1) == nullptr);
+    before = g_heap_allocs;
+    for (int i = 0; i < 3; i++)
+        list.insertAtEnd(i, 0, 0);
+    CHECK(g_heap_allocs == before);
+}
+
+// ─── copy / move / swap tests ─────────────────────────────────────────────────
+
+static singlylist<Vec3, int, int, int> make_singly(int count)
+{
+    singlylist<Vec3, int, int, int> list;
+    for (int i = 1; i <= count; i++)
+        list.insertAtEnd(i, 0, 0);
+    return list;
+}
+
+void test_singly_copy_move_swap()
+{
+    begin_suite("singlylist: copy / move / swap");
+
+    singlylist<Vec3, int, int, int> a = make_singly(3);
+    CHECK(a.getStoragePtr(3)->x == 3);
+
+    // Deep copy owns its own payloads
+    singlylist<Vec3, int, int, int> b(a);
+    CHECK(b.getStoragePtr(1) != a.getStoragePtr(1));
+    b.getStoragePtr(1)->x = 100;
+    CHECK(a.getStoragePtr(1)->x == 1);
+    CHECK(b.getStoragePtr(3)->x == 3);
+    CHECK(b.getStoragePtr(4)    == nullptr);
+
+    // Copy assignment replaces existing contents
+    singlylist<Vec3, int, int, int> c = make_singly(5);
+    c = a;
+    CHECK(c.getStoragePtr(3)->x == 3);
+    CHECK(c.getStoragePtr(4)    == nullptr);
+    c = c; // self-assignment is a no-op
+    CHECK(c.getStoragePtr(3)->x == 3);
+
+    // Move steals the nodes without copying
+    auto *first = a.getNode(1);
+    singlylist<Vec3, int, int, int> d(static_cast<singlylist<Vec3, int, int, int> &&>(a));
+    CHECK(d.getNode(1)       == first);
+    CHECK(a.getNode(1)       == nullptr);
+    CHECK(a.deleteFromPosition(1) == false);
+    a.insertAtEnd(7, 0, 0); // moved-from list is reusable
+    CHECK(a.getStoragePtr(1)->x == 7);
+
+    c = static_cast<singlylist<Vec3, int, int, int> &&>(d);
+    CHECK(c.getNode(1) == first);
+    CHECK(d.getNode(1) == nullptr);
+
+    // Swap
+    c.swap(a);
+    CHECK(a.getNode(1)       == first);
+    CHECK(a.getStoragePtr(3)->x == 3);
+    CHECK(c.getStoragePtr(1)->x == 7);
+    CHECK(c.getStoragePtr(2)    == nullptr);
+    a.insertAtEnd(4, 0, 0); // tail survived the swap
+    CHECK(a.getStoragePtr(4)->x == 4);
+
+    // Lists can live in standard containers
+    std::vector<singlylist<Vec3, int, int, int>> lists;
+    for (int i = 1; i <= 8; i++)
+        lists.push_back(make_singly(i));
+    bool ok = true;
+    for (int i = 1; i <= 8; i++)
+        ok = ok && lists[i - 1].getStoragePtr(i)->x == i && lists[i - 1].getStoragePtr(i + 1) == nullptr;
+    CHECK(ok);
+}
+
+void test_singly_inline_move()
+{
+    begin_suite("singlylist: move with inline node slots");
+    typedef basic_singlylist<inlinetraits<2>, Vec3, int, int, int> small_list;
+
+    small_list a;
+    for (int i = 1; i <= 4; i++)
+        a.insertAtEnd(i, 0, 0);
+    auto *heap_node = a.getNode(3);
+
+    size_t before = g_heap_allocs;
+    small_list b(static_cast<small_list &&>(a));
+    CHECK(g_heap_allocs == before);              // no allocation on move
+    CHECK(node_is_inline(b, b.getNode(1)));      // relocated into b's slots
+    CHECK(b.getNode(3)  == heap_node);           // heap nodes are stolen
+    for (int i = 1; i <= 4; i++)
+        CHECK(b.getStoragePtr(i)->x == i);
+    CHECK(a.getNode(1) == nullptr);
+
+    // a's inline slots were handed back and are reusable
+    CHECK(node_is_inline(a, a.insertAtEnd(9, 0, 0)));
+    CHECK(g_heap_allocs == before);
+
+    a.swap(b);
+    CHECK(a.getStoragePtr(4)->x == 4);
+    CHECK(b.getStoragePtr(1)->x == 9);
+    CHECK(b.getStoragePtr(2)    == nullptr);
+
+    small_list c(a);
+    CHECK(c.getStoragePtr(4)->x == 4);
+    CHECK(node_is_inline(c, c.getNode(2)));
+}
+
+void test_cdl_copy_move_swap()
+{
+    begin_suite("circulardoublylist: copy / move / swap");
+    typedef circulardoublylist<Vec3, int, int, int> cdl;
+
+    cdl a;
+    for (int i = 1; i <= 4; i++)
+        a.insertAtEnd(i, 0, 0);
+
+    cdl b(a);
+    CHECK(b.getStoragePtr(1) != a.getStoragePtr(1));
+    for (int i = 1; i <= 4; i++)
+        CHECK(b.getStoragePtr(i)->x == i);
+    CHECK(b.getStoragePtr(5) == nullptr);
+
+    cdl c;
+    c.insertAtEnd(50, 0, 0);
+    c = b;
+    CHECK(c.getStoragePtr(4)->x == 4);
+    CHECK(c.getStoragePtr(5)    == nullptr);
+
+    Vec3 *first = a.getStoragePtr(1);
+    cdl d(static_cast<cdl &&>(a));
+    CHECK(d.getStoragePtr(1) == first);
+    CHECK(d.getStoragePtr(4)->x == 4);
+    CHECK(a.getStoragePtr(1) == nullptr);
+    CHECK(a.getLastAccessedNode() == nullptr);
+
+    c = static_cast<cdl &&>(d);
+    CHECK(c.getStoragePtr(1) == first);
+    CHECK(d.getStoragePtr(1) == nullptr);
+
+    a.insertAtEnd(8, 0, 0);
+    a.swap(c);
+    CHECK(a.getStoragePtr(1) == first);
+    CHECK(c.getStoragePtr(1)->x == 8);
+    CHECK(c.getStoragePtr(2)    == nullptr);
+
+    // circular links intact after moving
+    auto *tail = a.insertAtEnd(5, 0, 0);
+    CHECK(tail->n->sp == first);
+
+    typedef basic_circulardoublylist<inlinetraits<2>, Vec3, int, int, int> small_cdl;
+    small_cdl e;
+    for (int i = 1; i <= 3; i++)
+        e.insertAtEnd(i, 0, 0);
+    size_t before = g_heap_allocs;
+    small_cdl f(static_cast<small_cdl &&>(e));
+    CHECK(g_heap_allocs == before);
+    for (int i = 1; i <= 3; i++)
+        CHECK(f.getStoragePtr(i)->x == i);
+    CHECK(node_is_inline(f, f.getStoragePtr(1)));
+    CHECK(e.getStoragePtr(1) == nullptr);
+}
+
+// ─── iteration / prefetch tests ───────────────────────────────────────────────
+
+void test_singly_iteration_prefetch()
+{
+    begin_suite("singlylist: iteration and prefetching walks");
+
+    singlylist<Vec3, int, int, int> plain;
+    CHECK(!(plain.begin() != plain.end())); // empty range
+    for (int i = 1; i <= 5; i++)
+        plain.insertAtEnd(i, 0, 0);
+    int sum = 0;
+    for (Vec3 &v : plain)
+        sum += v.x;
+    CHECK(sum == 15);
+    auto it = plain.begin();
+    CHECK(it.node() == plain.getNode(1));
+    ++it;
+    CHECK(it->x == 2);
+
+    // Results must not depend on the prefetch distance, including when the
+    // distance exceeds the list length
+    basic_singlylist<prefetchtraits<3>, Vec3, int, int, int> fetched;
+    for (int i = 1; i <= 10; i++)
+        fetched.insertAtEnd(i, 0, 0);
+    bool ok = true;
+    for (int i = 1; i <= 10; i++)
+        ok = ok && fetched.getStoragePtr(i)->x == i;
+    CHECK(ok);
+    sum = 0;
+    for (Vec3 &v : fetched)
+        sum += v.x;
+    CHECK(sum == 55);
+    CHECK(fetched.deleteFromPosition(10) == true);
+    CHECK(fetched.getStoragePtr(9)->x == 9);
+    fetched.clear();
+    CHECK(fetched.getStoragePtr(1) == nullptr);
+    CHECK(!(fetched.begin() != fetched.end()));
+
+    basic_singlylist<prefetchtraits<16>, Vec3, int, int, int> short_list;
+    short_list.insertAtEnd(1, 0, 0);
+    short_list.insertAtEnd(2, 0, 0);
+    CHECK(short_list.getStoragePtr(2)->x == 2);
+    short_list.clear();
+    CHECK(short_list.getNode(1) == nullptr);
+}
+
+void test_cdl_iteration_prefetch()
+{
+    begin_suite("circulardoublylist: iteration and prefetching walks");
+
+    circulardoublylist<Vec3, int, int, int> plain;
+    CHECK(!(plain.begin() != plain.end()));
+    for (int i = 1; i <= 5; i++)
+        plain.insertAtEnd(i, 0, 0);
+    int sum = 0;
+    int visited = 0;
+    for (Vec3 &v : plain)
+    {
+        sum += v.x;
+        ++visited;
+    }
+    CHECK(sum     == 15);
+    CHECK(visited == 5); // exactly one lap
+
+    basic_circulardoublylist<prefetchtraits<4>, Vec3, int, int, int> fetched;
+    for (int i = 1; i <= 12; i++)
+        fetched.insertAtEnd(i, 0, 0);
+    bool ok = true;
+    for (int i = 1; i <= 12; i++) // both forward and backward walks
+        ok = ok && fetched.getStoragePtr(i)->x == i;
+    CHECK(ok);
+    sum = 0;
+    for (Vec3 &v : fetched)
+        sum += v.x;
+    CHECK(sum == 78);
+    fetched.clear();
+    CHECK(fetched.getStoragePtr(1) == nullptr);
+    fetched.insertAtEnd(3, 0, 0);
+    CHECK(fetched.getStoragePtr(1)->x == 3);
+}
+
+// ─── size_type tests ──────────────────────────────────────────────────────────
+
+void test_small_size_type()
+{
+    begin_suite("size_type: uint8_t counts and positions");
+    typedef basic_singlylist<sizetraits<uint8_t>, Vec3, int, int, int> tiny_singly;
+    typedef basic_circulardoublylist<sizetraits<uint8_t>, Vec3, int, int, int> tiny_cdl;
+
+    // The circular list keeps only head, tail, lastnode and the count
+    CHECK(sizeof(circulardoublylist<Vec3, int, int, int>) == sizeof(singlylist<Vec3, int, int, int>));
+    CHECK(sizeof(tiny_cdl)    <= sizeof(circulardoublylist<Vec3, int, int, int>));
+    CHECK(sizeof(tiny_singly) <= sizeof(singlylist<Vec3, int, int, int>));
+    CHECK(sizelimit<uint8_t>::max  == 255);
+    CHECK(sizelimit<int16_t>::max  == 32767);
+    CHECK(sizelimit<uint32_t>::max == 4294967295U);
+
+    tiny_singly list;
+    CHECK(list.insertAtPosition(0, 0, 0, 0) == nullptr);
+    CHECK(list.insertAtPosition(2, 0, 0, 0) == nullptr);
+    for (int i = 1; i <= 255; i++)
+        list.insertAtEnd(i, 0, 0);
+    CHECK(list.size()                        == 255);
+    CHECK(list.insertAtEnd(0, 0, 0)          == nullptr); // count would overflow
+    CHECK(list.insertAtBeginning(0, 0, 0)    == nullptr);
+    CHECK(list.insertAtPosition(255, 0, 0, 0) == nullptr);
+    CHECK(list.size()                        == 255);
+    CHECK(list.getStoragePtr(255)->x         == 255);
+    CHECK(list.getStoragePtr(0)              == nullptr);
+    CHECK(list.deleteFromPosition(0)         == false);
+    CHECK(list.deleteFromPosition(255)       == true);
+    CHECK(list.insertAtPosition(255, 7, 0, 0) != nullptr); // append at size + 1
+    CHECK(list.getStoragePtr(255)->x         == 7);
+    list.clear();
+    CHECK(list.size() == 0);
+
+    tiny_cdl dlist;
+    CHECK(dlist.insertAtPosition(0, 0, 0, 0) == nullptr);
+    for (int i = 1; i <= 200; i++)
+        dlist.insertAtEnd(i, 0, 0);
+    bool ok = true;
+    for (int i = 1; i <= 200; i++) // forward and backward walks
+        ok = ok && dlist.getStoragePtr((uint8_t)i)->x == i;
+    CHECK(ok);
+    CHECK(dlist.insertAtPosition(202, 0, 0, 0) == nullptr);
+    CHECK(dlist.insertAtPosition(201, 9, 0, 0) != nullptr);
+    CHECK(dlist.size()                         == 201);
+    CHECK(dlist.deleteFromPosition(202)        == false);
+    CHECK(dlist.deleteFromPosition(100)        == true);
+    CHECK(dlist.getStoragePtr(100)->x          == 101);
+}
+
+// ─── reserve tests ────────────────────────────────────────────────────────────
+
+// Buckets each insert by the allocator calls it made: [0] none, [1] one or more
+template <typename List>
+static void insert_alloc_histogram(List &list, int count, size_t (&histogram)[2])
+{
+    histogram[0] = histogram[1] = 0;
+    for (int i = 0; i < count; i++)
+    {
+        size_t before = g_heap_allocs;
+        list.insertAtEnd(i, 0, 0);
+        ++histogram[g_heap_allocs == before ? 0 : 1];
+    }
+}
+
+struct inlinereservetraits : reservetraits
+{
+    static const uint8_t inline_nodes = 4;
+};
+
+void test_singly_reserve()
+{
+    begin_suite("singlylist: reserve / shrink_to_fit");
+
+    // only reservable lists carry the spare-slot state
+    CHECK(sizeof(singlylist<Vec3, int, int, int>) == sizeof(basic_singlylist<inlinetraits<0>, Vec3, int, int, int>));
+    CHECK(sizeof(singlylist<Vec3, int, int, int>) <= 4 * sizeof(void *));
+    CHECK(sizeof(basic_singlylist<reservetraits, Vec3, int, int, int>) > sizeof(singlylist<Vec3, int, int, int>));
+
+    basic_singlylist<reservetraits, Vec3, int, int, int> list;
+    CHECK(list.capacity() == 0);
+    CHECK(list.reserve(64) == true);
+    CHECK(list.capacity() == 64);
+    CHECK(list.size()     == 0);
+
+    size_t histogram[2];
+    insert_alloc_histogram(list, 64, histogram);
+    CHECK(histogram[0] == 64); // every insert took a reserved slot
+    CHECK(histogram[1] == 0);
+    CHECK(list.getStoragePtr(64)->x == 63);
+
+    // Deletes return slots while below the reservation
+    size_t before = g_heap_allocs;
+    list.deleteFromPosition(10);
+    list.removeAtBeginning();
+    CHECK(list.capacity() == 64);
+    list.insertAtPosition(5, 7, 0, 0);
+    list.insertAtBeginning(8, 0, 0);
+    CHECK(g_heap_allocs == before);
+    list.insertAtEnd(9, 0, 0); // 65th node allocates
+    CHECK(g_heap_allocs == before + 1);
+
+    list.clear();
+    CHECK(list.capacity() == 64); // clear keeps the reserved slots
+    insert_alloc_histogram(list, 64, histogram);
+    CHECK(histogram[1] == 0);
+
+    list.clear();
+    list.shrink_to_fit();
+    CHECK(list.capacity() == 0);
+    list.insertAtEnd(1, 0, 0);
+    list.removeAtBeginning(); // no reservation: slot goes back to the heap
+    CHECK(list.capacity() == 0);
+
+    // Reserving less than the size keeps everything; inline slots count
+    list.reserve(4);
+    for (int i = 0; i < 6; i++)
+        list.insertAtEnd(i, 0, 0);
+    CHECK(list.reserve(3) == true);
+    CHECK(list.capacity() == 6);
+    basic_singlylist<inlinereservetraits, Vec3, int, int, int> small;
+    before = g_heap_allocs;
+    small.reserve(6);
+    CHECK(g_heap_allocs == before + 2);
+    CHECK(small.capacity() == 6);
+}
+
+void test_cdl_reserve()
+{
+    begin_suite("circulardoublylist: reserve / shrink_to_fit");
+
+    CHECK(sizeof(circulardoublylist<Vec3, int, int, int>) <= 4 * sizeof(void *));
+    basic_circulardoublylist<reservetraits, Vec3, int, int, int> list;
+    CHECK(list.reserve(32) == true);
+    size_t histogram[2];
+    insert_alloc_histogram(list, 32, histogram);
+    CHECK(histogram[0] == 32);
+    CHECK(histogram[1] == 0);
+
+    size_t before = g_heap_allocs;
+    for (int i = 0; i < 100; i++) // steady churn stays off the allocator
+    {
+        list.deleteFromPosition(1 + i % list.size());
+        list.insertAtPosition(1 + i % list.size(), i, 0, 0);
+    }
+    CHECK(g_heap_allocs == before);
+    CHECK(list.size()     == 32);
+    CHECK(list.capacity() == 32);
+
+    list.deleteFromPosition(32);
+    list.shrink_to_fit();
+    CHECK(list.capacity() == 31);
+    list.clear();
+    CHECK(list.capacity() == 0);
+}
+
+// ─── bulk delete tests ────────────────────────────────────────────────────────
+
+// Compares the x fields in list order; never allocates, so it can sit inside
+// g_heap_allocs checks
+template <typename List>
+static bool list_matches(List &list, std::initializer_list<int> expected)
+{
+    if ((size_t)list.size() != expected.size())
+        return false;
+    const int *want = expected.begin();
+    for (Vec3 &v : list)
+        if (v.x != *want++)
+            return false;
+    return true;
+}
+
+void test_singly_remove_if_range()
+{
+    begin_suite("singlylist: removeIf / deleteRange");
+
+    singlylist<Vec3, int, int, int> list;
+    CHECK(list.removeIf([](Vec3 &) { return true; }) == 0);
+    CHECK(list.deleteRange(1, 1) == false);
+    for (int i = 1; i <= 10; i++)
+        list.insertAtEnd(i, 0, 0);
+
+    list.getStoragePtr(4); // lastnode on a node that will be removed
+    CHECK(list.removeIf([](Vec3 &v) { return v.x % 2 == 0; }) == 5);
+    CHECK(list_matches(list, {1, 3, 5, 7, 9}));
+    CHECK(list.getLastAccessedNode() == nullptr);
+    CHECK(list.insertAtEnd(11, 0, 0)->n == nullptr); // tail still valid
+
+    CHECK(list.removeIf([](Vec3 &v) { return v.x == 1 || v.x == 11; }) == 2); // head and tail
+    CHECK(list_matches(list, {3, 5, 7, 9}));
+    CHECK(list.insertAtEnd(13, 0, 0) == list.getNode(5));
+
+    CHECK(list.deleteRange(0, 2) == false);
+    CHECK(list.deleteRange(3, 2) == false);
+    CHECK(list.deleteRange(4, 6) == false);
+    CHECK(list.deleteRange(2, 3) == true);
+    CHECK(list_matches(list, {3, 9, 13}));
+    CHECK(list.deleteRange(2, 3) == true); // run ending at the tail
+    CHECK(list_matches(list, {3}));
+    list.insertAtEnd(4, 0, 0);
+    CHECK(list.getNode(1)->n->sp->x == 4);
+    CHECK(list.deleteRange(1, 2) == true); // whole list
+    CHECK(list.size() == 0);
+    CHECK(list.insertAtEnd(1, 0, 0) == list.getNode(1));
+
+    list.insertAtEnd(2, 0, 0);
+    CHECK(list.removeIf([](Vec3 &) { return true; }) == 2);
+    CHECK(list.getNode(1) == nullptr);
+
+    basic_singlylist<sizetraits<uint8_t>, Vec3, int, int, int> full; // last at size_type's maximum
+    for (int i = 1; i <= 255; i++)
+        full.insertAtEnd(i, 0, 0);
+    CHECK(full.deleteRange(2, 255) == true && list_matches(full, {1}));
+    for (int i = 2; i <= 255; i++)
+        full.insertAtEnd(i, 0, 0);
+    CHECK(full.deleteRange(1, full.size()) == true && full.size() == 0);
+}
+
+void test_cdl_remove_if_range()
+{
+    begin_suite("circulardoublylist: removeIf / deleteRange");
+
+    circulardoublylist<Vec3, int, int, int> list;
+    CHECK(list.removeIf([](Vec3 &) { return true; }) == 0);
+    for (int i = 1; i <= 10; i++)
+        list.insertAtEnd(i, 0, 0);
+
+    CHECK(list.removeIf([](Vec3 &v) { return v.x == 1 || v.x % 3 == 0 || v.x == 10; }) == 5);
+    CHECK(list_matches(list, {2, 4, 5, 7, 8}));
+    CHECK(list.getLastAccessedNode() == nullptr); // lastnode (10) was removed
+    circulardoublylist<Vec3, int, int, int>::circlynode *head = list.begin().node();
+    CHECK(head->p->sp->x == 8); // wrap fixed up both ways
+    CHECK(head->p->n     == head);
+
+    CHECK(list.deleteRange(5, 4) == false);
+    CHECK(list.deleteRange(1, 6) == false);
+    CHECK(list.deleteRange(2, 3) == true);
+    CHECK(list_matches(list, {2, 7, 8}));
+    CHECK(list.deleteRange(1, 1) == true);
+    head = list.begin().node();
+    CHECK(head->sp->x == 7 && head->p->sp->x == 8 && head->n->n == head);
+    CHECK(list.deleteRange(1, 2) == true);
+    CHECK(list.size() == 0);
+    CHECK(list.insertAtEnd(3, 0, 0) != nullptr);
+    CHECK(list_matches(list, {3}));
+
+    basic_circulardoublylist<sizetraits<uint8_t>, Vec3, int, int, int> full; // last at size_type's maximum
+    for (int i = 1; i <= 255; i++)
+        full.insertAtEnd(i, 0, 0);
+    CHECK(full.deleteRange(2, 255) == true && list_matches(full, {1}));
+    for (int i = 2; i <= 255; i++)
+        full.insertAtEnd(i, 0, 0);
+    CHECK(full.deleteRange(1, full.size()) == true && full.size() == 0);
+}
+
+// ─── relinking algorithm tests ────────────────────────────────────────────────
+
+void test_singly_reverse_partition_unique()
+{
+    begin_suite("singlylist: reverse / partition / unique");
+
+    singlylist<Vec3, int, int, int> list;
+    list.reverse();
+    CHECK(list.partition([](Vec3 &) { return true; }) == nullptr);
+    CHECK(list.unique([](Vec3 &, Vec3 &) { return true; }) == 0);
+
+    for (int i = 1; i <= 6; i++)
+        list.insertAtEnd(i, 0, 0);
+    Vec3 *third = list.getStoragePtr(3);
+    size_t before = g_heap_allocs;
+    list.reverse();
+    CHECK(g_heap_allocs == before);
+    CHECK(list_matches(list, {6, 5, 4, 3, 2, 1}));
+    CHECK(list.getStoragePtr(4) == third); // relinked, not copied
+    CHECK(list.insertAtEnd(0, 0, 0)->sp->x == 0);
+    CHECK(list.getNode(6)->n->sp->x == 0); // tail fixed up
+    list.deleteFromPosition(7);
+
+    before = g_heap_allocs;
+    singlylist<Vec3, int, int, int>::singlynode *split = list.partition([](Vec3 &v) { return v.x % 2 == 1; });
+    CHECK(g_heap_allocs == before);
+    CHECK(list_matches(list, {5, 3, 1, 6, 4, 2})); // stable
+    CHECK(split == list.getNode(4));
+    CHECK(list.insertAtEnd(8, 0, 0) == list.getNode(7));
+    list.deleteFromPosition(7);
+    CHECK(list.partition([](Vec3 &) { return false; }) == list.getNode(1));
+    CHECK(list.partition([](Vec3 &) { return true; })  == nullptr);
+    CHECK(list_matches(list, {5, 3, 1, 6, 4, 2}));
+
+    list.clear();
+    for (int x : {1, 1, 2, 3, 3, 3, 1, 4, 4})
+        list.insertAtEnd(x, 0, 0);
+    CHECK(list.unique([](Vec3 &a, Vec3 &b) { return a.x == b.x; }) == 4);
+    CHECK(list_matches(list, {1, 2, 3, 1, 4}));
+    CHECK(list.insertAtEnd(5, 0, 0) == list.getNode(6)); // duplicate tail removed cleanly
+}
+
+void test_cdl_reverse_partition_unique()
+{
+    begin_suite("circulardoublylist: reverse / partition / unique");
+
+    circulardoublylist<Vec3, int, int, int> list;
+    list.reverse();
+    CHECK(list.partition([](Vec3 &) { return true; }) == nullptr);
+    CHECK(list.unique([](Vec3 &, Vec3 &) { return true; }) == 0);
+
+    for (int i = 1; i <= 6; i++)
+        list.insertAtEnd(i, 0, 0);
+    Vec3 *third = list.getStoragePtr(3);
+    size_t before = g_heap_allocs;
+    list.reverse();
+    CHECK(g_heap_allocs == before);
+    CHECK(list_matches(list, {6, 5, 4, 3, 2, 1}));
+    CHECK(list.getStoragePtr(4) == third);
+    CHECK(list.getStoragePtr(5)->x == 2); // backward walk uses the new p links
+    circulardoublylist<Vec3, int, int, int>::circlynode *head = list.begin().node();
+    CHECK(head->p->sp->x == 1 && head->p->n == head);
+
+    circulardoublylist<Vec3, int, int, int>::circlynode *split = list.partition([](Vec3 &v) { return v.x > 3; });
+    CHECK(list_matches(list, {6, 5, 4, 3, 2, 1}));
+    CHECK(split->sp->x == 3);
+    before = g_heap_allocs;
+    split = list.partition([](Vec3 &v) { return v.x % 2 == 0; });
+    CHECK(g_heap_allocs == before);
+    CHECK(list_matches(list, {6, 4, 2, 5, 3, 1}));
+    CHECK(split->sp->x == 5 && split->p->sp->x == 2);
+    head = list.begin().node();
+    bool links = true;
+    for (int i = 0; i < 6; i++, head = head->n)
+        links = links && head->n->p == head && head->p->n == head;
+    CHECK(links);
+    CHECK(list.partition([](Vec3 &) { return false; }) == list.begin().node());
+
+    list.clear();
+    for (int x : {2, 2, 3, 3, 2, 2})
+        list.insertAtEnd(x, 0, 0);
+    CHECK(list.unique([](Vec3 &a, Vec3 &b) { return a.x == b.x; }) == 3);
+    CHECK(list_matches(list, {2, 3, 2})); // tail is not merged into the head
+    CHECK(list.getStoragePtr(3)->x == 2);
+    head = list.begin().node();
+    CHECK(head->p->sp->x == 2 && head->p->n == head);
+}
+
+// ─── view tests ───────────────────────────────────────────────────────────────
+
+void test_views()
+{
+    begin_suite("views: filter / map / take / skip / reverse");
+
+    singlylist<Vec3, int, int, int> list;
+    CHECK(view(list).count() == 0);
+    CHECK(view(list).filter([](Vec3 &) { return true; }).take(3).count() == 0);
+    for (int i = 1; i <= 10; i++)
+        list.insertAtEnd(i, i % 3 == 0, 0);
+
+    // sum of x over elements with the y flag set, first 2 only
+    size_t before = g_heap_allocs;
+    int visits = 0;
+    int sum = view(list)
+                  .filter([&visits](Vec3 &v) { ++visits; return v.y != 0; })
+                  .map([](Vec3 &v) { return v.x; })
+                  .take(2)
+                  .fold(0, [](int acc, int x) { return acc + x; });
+    CHECK(sum == 3 + 6);
+    CHECK(visits == 6); // fused and lazy: stops at the second match
+    CHECK(g_heap_allocs == before);
+
+    std::vector<int> seen;
+    for (int x : view(list).skip(7).map([](const Vec3 &v) { return v.x * 10; }))
+        seen.push_back(x);
+    CHECK(seen == std::vector<int>({80, 90, 100}));
+    CHECK(view(list).skip(20).count()          == 0);
+    CHECK(view(list).take(20).count()          == 10);
+    CHECK(view(list).skip(2).take(3).count()   == 3);
+    CHECK(view(list).take(3).skip(2).count()   == 1);
+    CHECK(view(list).filter([](Vec3 &v) { return v.x > 4; }).skip(1).take(2)
+              .fold(0, [](int acc, Vec3 &v) { return acc * 10 + v.x; }) == 67);
+
+    for (Vec3 &v : view(list).filter([](Vec3 &v) { return v.x % 2 == 0; }))
+        v.z = 1; // views yield references into the list
+    CHECK(list.getStoragePtr(4)->z == 1 && list.getStoragePtr(5)->z == 0);
+
+    circulardoublylist<Vec3, int, int, int> dlist;
+    CHECK(view(dlist).reverse().count() == 0);
+    for (int i = 1; i <= 6; i++)
+        dlist.insertAtEnd(i, 0, 0);
+    seen.clear();
+    for (int x : view(dlist).reverse().filter([](Vec3 &v) { return v.x != 5; }).map([](Vec3 &v) { return v.x; }).take(3))
+        seen.push_back(x);
+    CHECK(seen == std::vector<int>({6, 4, 3}));
+    CHECK(view(dlist).skip(5).fold(0, [](int, Vec3 &v) { return v.x; }) == 6);
+
+    CHECK(view(k_static_vecs).filter([](const Vec3 &v) { return v.x > 1; }).count() == 2);
+}
+
+// ─── array export / import tests ─────────────────────────────────────────────
+
+struct Tagged // not trivially copyable: exercises the assignment path
+{
+    int x;
+    Tagged() : x(0) {}
+    Tagged(int v) : x(v) {}
+    Tagged(const Tagged &other) : x(other.x) {}
+    Tagged &operator=(const Tagged &other) { x = other.x + 1000; return *this; }
+};
+
+void test_array_export_import()
+{
+    begin_suite("copyTo / toArray / fromArray");
+
+    const Vec3 source[5] = {{1, 0, 0}, {2, 0, 0}, {3, 0, 0}, {4, 0, 0}, {5, 0, 0}};
+    singlylist<Vec3, int, int, int> list;
+    Vec3 out[8] = {};
+    CHECK(list.copyTo(out, 8)          == 0);
+    CHECK(list.fromArray(source, 5)    == 5);
+    CHECK(list.fromArray(source, 0)    == 0);
+    CHECK(list_matches(list, {1, 2, 3, 4, 5}));
+    CHECK(list.copyTo(out, 3)          == 3);
+    CHECK(out[2].x == 3 && out[3].x == 0);
+    CHECK(list.toArray(out)            == 5);
+    CHECK(out[4].x == 5 && out[5].x == 0);
+    CHECK(list.fromArray(source + 3, 2) == 2); // appends
+    CHECK(list.size() == 7 && list.getStoragePtr(7)->x == 5);
+
+    circulardoublylist<Vec3, int, int, int> dlist;
+    CHECK(dlist.fromArray(source, 5) == 5);
+    dlist.reverse();
+    Vec3 small[3];
+    CHECK(dlist.toArray(small) == 3);
+    CHECK(small[0].x == 5 && small[2].x == 3);
+    CHECK(dlist.copyTo(out, 100) == 5);
+    CHECK(out[4].x == 1);
+
+    Vec3 flat[3];
+    CHECK(k_static_vecs.copyTo(flat, 3) == 3);
+    CHECK(flat[2].z == 9);
+    CHECK(k_static_vecs.copyTo(flat, 2) == 2);
+
+    // Non-trivially-copyable payloads go through their own copy operations
+    const Tagged tags[2] = {Tagged(1), Tagged(2)};
+    singlylist<Tagged, int> tagged;
+    CHECK(tagged.fromArray(tags, 2) == 2);
+    CHECK(tagged.getStoragePtr(2)->x == 2); // copy-constructed
+    Tagged tag_out[2];
+    CHECK(tagged.copyTo(tag_out, 2) == 2);
+    CHECK(tag_out[0].x == 1001);          // assigned, not memcpy'd
+
+    // The uint8_t-sized list caps fromArray at its 255-node limit
+    static Vec3 many[300];
+    basic_singlylist<sizetraits<uint8_t>, Vec3, int, int, int> tiny;
+    CHECK(tiny.fromArray(many, 255) == 255);
+    CHECK(tiny.fromArray(many, 10)  == 0);
+}
+
+// ─── timer wheel tests ────────────────────────────────────────────────────────
+
+struct FakeClock
+{
+    uint32_t ticks;
+    uint32_t now() const { return ticks; }
+};
+
+struct TimerProbe
+{
+    FakeClock *clock;
+    uint32_t expected; // tick the timer should fire at
+    int fired;
+    bool on_time;
+};
+
+static void probe_fired(void *context)
+{
+    TimerProbe *probe = static_cast<TimerProbe *>(context);
+    probe->on_time = probe->on_time && probe->clock->ticks >= probe->expected && probe->fired == 0;
+    ++probe->fired;
+}
+
+typedef timerwheel<FakeClock, 3, 3> small_wheel; // 8 buckets per level, spans 512 ticks
+
+struct Periodic
+{
+    small_wheel *wheel;
+    int runs;
+};
+
+static void periodic_fired(void *context)
+{
+    Periodic *periodic = static_cast<Periodic *>(context);
+    if (++periodic->runs < 5)
+        periodic->wheel->schedule(100, periodic_fired, periodic);
+}
+
+void test_timer_wheel()
+{
+    begin_suite("timerwheel: schedule / cancel / cascade");
+
+    FakeClock clock = {0xFFFFFE00U}; // wraps around during the test
+    small_wheel wheel(clock, 200);
+    CHECK(wheel.available() == 200);
+    CHECK(wheel.pending()   == 0);
+
+    // Deadlines across every level, past the span, and on level boundaries
+    static TimerProbe probes[150];
+    small_wheel::timerhandle handles[150];
+    size_t before = g_heap_allocs;
+    for (int i = 0; i < 150; i++)
+    {
+        uint32_t delay = (uint32_t)(i * i * 7 % 1500 + (i % 8 == 0 ? 64 - (i % 3) : 1));
+        probes[i] = TimerProbe{&clock, clock.ticks + delay, 0, true};
+        handles[i] = wheel.schedule(delay, probe_fired, &probes[i]);
+    }
+    CHECK(wheel.pending() == 150);
+    int cancelled = 0;
+    for (int i = 0; i < 150; i += 10)
+        cancelled += wheel.cancel(handles[i]);
+    CHECK(cancelled == 15);
+    CHECK(wheel.cancel(handles[0]) == false); // already cancelled
+    CHECK(wheel.cancel(nullptr)    == false);
+
+    // Advance one tick at a time: every timer fires exactly on its deadline
+    bool exact = true;
+    for (int step = 0; step < 1600; step++)
+    {
+        ++clock.ticks;
+        wheel.poll();
+        for (int i = 0; i < 150; i++)
+            if (i % 10 != 0 && probes[i].expected == clock.ticks)
+                exact = exact && probes[i].fired == 1;
+    }
+    CHECK(exact);
+    int fired = 0;
+    bool on_time = true;
+    for (int i = 0; i < 150; i++)
+    {
+        fired += probes[i].fired;
+        on_time = on_time && probes[i].on_time;
+    }
+    CHECK(fired   == 135);
+    CHECK(on_time);
+    CHECK(wheel.isScheduled(handles[1]) == false);
+    CHECK(wheel.pending()   == 0);
+    CHECK(g_heap_allocs     == before); // scheduling and expiry never allocate
+
+    // Catch-up poll after a long gap, and zero delay
+    TimerProbe late = {&clock, clock.ticks + 1000, 0, true};
+    TimerProbe soon = {&clock, clock.ticks + 1, 0, true};
+    wheel.schedule(1000, probe_fired, &late);
+    wheel.schedule(0, probe_fired, &soon);
+    clock.ticks += 5000;
+    CHECK(wheel.poll() == 2);
+    CHECK(late.fired == 1 && soon.fired == 1);
+
+    // Callbacks may reschedule themselves
+    Periodic periodic = {&wheel, 0};
+    wheel.schedule(100, periodic_fired, &periodic);
+    for (int step = 0; step < 600; step++)
+    {
+        clock.ticks += 3;
+        wheel.poll();
+    }
+    CHECK(periodic.runs == 5);
+
+    // The pool bounds the number of pending timers
+    small_wheel tiny(clock, 2);
+    CHECK(tiny.schedule(5, nullptr) != nullptr);
+    CHECK(tiny.schedule(5, nullptr) != nullptr);
+    CHECK(tiny.schedule(5, nullptr) == nullptr);
+    clock.ticks += 5;
+    CHECK(tiny.poll()      == 2);
+    CHECK(tiny.available() == 2);
+}
+
+void test_cdl_splice()
+{
+    begin_suite("circulardoublylist: deleteNode / splice");
+
+    circulardoublylist<Vec3, int, int, int> a;
+    circulardoublylist<Vec3, int, int, int> b;
+    circulardoublylist<Vec3, int, int, int>::circlynode *nodes[4];
+    for (int i = 0; i < 4; i++)
+        nodes[i] = a.insertAtEnd(i + 1, 0, 0);
+
+    CHECK(a.deleteNode(nullptr)  == false);
+    CHECK(a.deleteNode(nodes[1]) == true);
+    CHECK(list_matches(a, {1, 3, 4}));
+
+    size_t before = g_heap_allocs;
+    CHECK(b.spliceAtEnd(nodes[3], a) == true); // tail
+    CHECK(b.spliceAtEnd(nodes[0], a) == true); // head
+    CHECK(list_matches(a, {3}));
+    CHECK(list_matches(b, {4, 1}));
+    CHECK(b.spliceAtEnd(nodes[3], b) == true); // rotate within a list
+    CHECK(list_matches(b, {1, 4}));
+    CHECK(b.spliceAllAtEnd(a) == true);
+    CHECK(list_matches(b, {1, 4, 3}));
+    CHECK(a.size() == 0 && a.begin() == a.end());
+    CHECK(a.spliceAllAtEnd(b) == true);      // into an empty list
+    CHECK(list_matches(a, {1, 4, 3}));
+    CHECK(a.spliceAllAtEnd(a) == false);
+    CHECK(g_heap_allocs == before);
+    CHECK(a.getStoragePtr(3)->x == 3);       // backward walk over spliced links
+
+    basic_circulardoublylist<inlinetraits<2>, Vec3, int, int, int> c;
+    basic_circulardoublylist<inlinetraits<2>, Vec3, int, int, int> d;
+    c.insertAtEnd(1, 0, 0);
+    CHECK(d.spliceAtEnd(c.begin().node(), c) == false); // inline slots stay put
+    CHECK(d.spliceAllAtEnd(c) == false);
+    CHECK(c.size() == 1);
+}
+
+void test_cdl_bounded()
+{
+    begin_suite("circulardoublylist: insertAtEndBounded sliding window");
+
+    circulardoublylist<Vec3, int, int, int> window;
+    CHECK(window.insertAtEndBounded(0, 1, 0, 0) == nullptr && window.size() == 0);
+    for (int i = 1; i <= 3; i++)
+        window.insertAtEndBounded(3, i, 0, 0);
+    CHECK(list_matches(window, {1, 2, 3}));
+
+    circulardoublylist<Vec3, int, int, int>::circlynode *head = window.begin().node();
+    size_t before = g_heap_allocs;
+    CHECK(window.insertAtEndBounded(3, 4, 0, 0) == head); // the head slot is reused
+    CHECK(list_matches(window, {2, 3, 4}) && window.size() == 3);
+    for (int i = 5; i <= 10; i++)
+        window.insertAtEndBounded(3, i, 0, 0);
+    CHECK(g_heap_allocs == before);
+    CHECK(list_matches(window, {8, 9, 10}) && window.getLastAccessedNodeStoragePtr()->x == 10);
+    CHECK(window.getStoragePtr(2)->x == 9 && window.rbegin()->x == 10);
+
+    window.insertAtEndBounded(2, 11, 0, 0); // above the bound: size is kept
+    CHECK(list_matches(window, {9, 10, 11}));
+    window.insertAtEndBounded(5, 12, 0, 0); // below the bound: grows
+    CHECK(list_matches(window, {9, 10, 11, 12}));
+    CHECK(window.deleteFromPosition(1) && window.insertAtBeginning(1, 0, 0) != nullptr);
+    CHECK(list_matches(window, {1, 10, 11, 12}));
+
+    circulardoublylist<Vec3, int, int, int> one;
+    one.insertAtEndBounded(1, 1, 0, 0);
+    one.insertAtEndBounded(1, 2, 0, 0);
+    CHECK(list_matches(one, {2}) && one.begin().node()->n == one.begin().node());
+}
+
+// ─── persistent list tests ────────────────────────────────────────────────────
+
+struct Counted // tracks live instances to observe node reclamation
+{
+    static int live;
+    int x;
+    Counted(int v) : x(v) { ++live; }
+    Counted(const Counted &other) : x(other.x) { ++live; }
+    ~Counted() { --live; }
+};
+int Counted::live = 0;
+
+void test_persistent_list()
+{
+    begin_suite("persistentlist: versions and snapshots");
+
+    {
+        persistentlist<Counted, int> list;
+        CHECK(list.size()  == 0);
+        CHECK(list.front() == nullptr);
+        CHECK(list.popFront() == false);
+        for (int i = 1; i <= 3; i++)
+            list.pushFront(i); // 3 2 1
+
+        size_t before = g_heap_allocs;
+        persistentlist<Counted, int> snap = list.snapshot();
+        CHECK(g_heap_allocs == before); // O(1), no copy
+        CHECK(snap.sharesWith(list));
+
+        list.popFront();
+        list.pushFront(9);
+        list.pushFront(8); // 8 9 2 1, sharing 2 1 with snap
+        CHECK(Counted::live == 5);
+        CHECK(snap.size() == 3 && snap.front()->x == 3);
+        CHECK(snap.getStoragePtr(3)->x == 1);
+        CHECK(list.size() == 4 && list.getStoragePtr(2)->x == 9);
+        CHECK(list.getStoragePtr(3) == snap.getStoragePtr(2)); // shared tail
+        CHECK(list.getStoragePtr(5) == nullptr);
+
+        int sum = 0;
+        for (const Counted &c : snap)
+            sum = sum * 10 + c.x;
+        CHECK(sum == 321);
+        CHECK(view(list).fold(0, [](int acc, const Counted &c) { return acc * 10 + c.x; }) == 8921);
+
+        snap.clear(); // node 3 is now unreachable
+        CHECK(Counted::live == 4);
+        persistentlist<Counted, int> moved(static_cast<persistentlist<Counted, int> &&>(list));
+        CHECK(list.size() == 0 && moved.size() == 4);
+        snap = moved;
+        snap = snap; // self-assignment keeps the nodes
+        CHECK(Counted::live == 4 && snap.size() == 4);
+        while (moved.popFront()) {}
+        CHECK(Counted::live == 4); // still reachable from snap
+        moved.pushFront(7);
+        CHECK(Counted::live == 5);
+    }
+    CHECK(Counted::live == 0);
+
+    {   // dropping a long list does not recurse
+        persistentlist<Counted, int> big;
+        for (int i = 0; i < 200000; i++)
+            big.pushFront(i);
+        persistentlist<Counted, int> half = big;
+        for (int i = 0; i < 100000; i++)
+            half.popFront();
+        big.clear();
+        CHECK(Counted::live == 100000);
+    }
+    CHECK(Counted::live == 0);
+
+    // Readers walk snapshots on other threads while the writer keeps changing
+    // its version; counts stay consistent and every node is reclaimed
+    {
+        persistentlist<int, int> writer;
+        for (int i = 0; i < 1000; i++)
+            writer.pushFront(1);
+        persistentlist<int, int> snaps[4];
+        for (persistentlist<int, int> &snap : snaps)
+            snap = writer.snapshot();
+        bool consistent[4] = {false, false, false, false};
+        std::thread readers[4];
+        for (int t = 0; t < 4; t++)
+            readers[t] = std::thread([&snaps, &consistent, t]() {
+                persistentlist<int, int> mine(static_cast<persistentlist<int, int> &&>(snaps[t]));
+                bool ok = true;
+                for (int round = 0; round < 50; round++)
+                {
+                    int total = 0;
+                    for (int x : mine)
+                        total += x;
+                    ok = ok && total == (int)mine.size();
+                    persistentlist<int, int> copy = mine.snapshot();
+                    copy.popFront();
+                }
+                consistent[t] = ok;
+            });
+        for (int round = 0; round < 2000; round++)
+        {
+            writer.popFront();
+            writer.pushFront(1);
+        }
+        for (std::thread &reader : readers)
+            reader.join();
+        CHECK(consistent[0] && consistent[1] && consistent[2] && consistent[3]);
+        CHECK(writer.size() == 1000);
+    }
+}
+
+// ─── rcu list tests ───────────────────────────────────────────────────────────
+
+struct Pair // readers check that b is always ~a, so a torn or freed node shows
+{
+    int a;
+    int b;
+};
+
+void test_rcu_list()
+{
+    begin_suite("rculist: readers, writer and reclamation");
+
+    {
+        basic_rculist<Counted, 2, int> list;
+        CHECK(list.insertAtEnd(2) != nullptr);
+        basic_rculist<Counted, 2, int>::rcunode *first = list.insertAtBeginning(1);
+        basic_rculist<Counted, 2, int>::rcunode *last = list.insertAtEnd(3);
+        CHECK(list.size() == 3 && Counted::live == 3);
+
+        basic_rculist<Counted, 2, int>::reader r1(list);
+        basic_rculist<Counted, 2, int>::reader r2(list);
+        CHECK(r1.isValid() && r2.isValid());
+        {
+            basic_rculist<Counted, 2, int>::reader r3(list);
+            CHECK(r3.isValid() == false); // only two slots
+        }
+
+        r1.lock();
+        int sum = 0;
+        for (const Counted &c : r1)
+            sum = sum * 10 + c.x;
+        CHECK(sum == 123);
+        CHECK(list.deleteNode(first));
+        CHECK(list.deleteNode(nullptr) == false);
+        CHECK(list.size() == 2 && list.retired() == 1);
+        CHECK(list.reclaim() == 0); // r1 may still hold the node
+        CHECK(Counted::live == 3);
+        CHECK(r1.begin()->x == 2);  // new readers' walks skip it
+        r1.unlock();
+        CHECK(list.reclaim() == 1);
+        CHECK(Counted::live == 2 && list.retired() == 0);
+
+        {
+            basic_rculist<Counted, 2, int>::readguard guard(r2); // section before the unlink
+            list.deleteNode(last);
+            CHECK(list.reclaim() == 0);
+        }
+        r1.lock(); // a section begun after the unlink does not hold it back
+        CHECK(list.reclaim() == 1);
+        r1.unlock();
+
+        for (int i = 0; i < 10; i++)
+            list.insertAtEnd(i);
+        CHECK(list.removeIf([](const Counted &c) { return c.x % 2 == 0; }) == 6);
+        list.synchronize();
+        CHECK(list.size() == 5 && Counted::live == 5);
+        sum = 0;
+        {
+            basic_rculist<Counted, 2, int>::readguard guard(r1);
+            for (const Counted &c : r1)
+                sum += c.x;
+        }
+        CHECK(sum == 1 + 3 + 5 + 7 + 9);
+    }
+    CHECK(Counted::live == 0);
+
+    // Readers walk and check every node while the writer churns the list; the
+    // writer reclaims as it goes, so freed memory would show as a broken pair
+    {
+        rculist<Pair, int, int> list;
+        for (int i = 0; i < 64; i++)
+            list.insertAtEnd(i, ~i);
+        listatomic<uint8_t> stop(0U);
+        bool consistent[4] = {false, false, false, false};
+        std::thread readers[4];
+        for (int t = 0; t < 4; t++)
+            readers[t] = std::thread([&list, &stop, &consistent, t]() {
+                rculist<Pair, int, int>::reader self(list);
+                bool ok = self.isValid();
+                while (ok && stop.load() == 0U)
+                {
+                    rculist<Pair, int, int>::readguard guard(self);
+                    size_t seen = 0U;
+                    int previous = 0;
+                    for (const Pair &pair : self)
+                    {
+                        ok = ok && pair.b == ~pair.a && (seen == 0U || pair.a == previous + 1);
+                        previous = pair.a;
+                        ++seen;
+                    }
+                    ok = ok && seen >= 64U; // inserts behind the walk only add to it
+                }
+                consistent[t] = ok;
+            });
+        for (int round = 0; round < 20000; round++)
+        {
+            list.insertAtEnd(round + 64, ~(round + 64));
+            list.removeIf([round](const Pair &pair) { return pair.a == round; });
+        }
+        stop.store(1U);
+        for (std::thread &reader : readers)
+            reader.join();
+        list.synchronize();
+        CHECK(consistent[0] && consistent[1] && consistent[2] && consistent[3]);
+        CHECK(list.size() == 64 && list.retired() == 0);
+    }
+}
+
+// ─── chunked list / simd kernel tests ─────────────────────────────────────────
+
+// Checks every listsimd kernel against listsimd<T, false> on runs of every
+// length up to 70, so each vector width sees whole blocks and every tail size
+template <typename T>
+static bool simd_matches_scalar(T low, T high)
+{
+    std::mt19937 rng(7);
+    T data[70];
+    const thresholdop ops[] = {THRESHOLD_EQUAL, THRESHOLD_LESS, THRESHOLD_LESS_EQUAL, THRESHOLD_GREATER, THRESHOLD_GREATER_EQUAL};
+    bool ok = true;
+    for (size_t count = 0; count <= 70; count++)
+    {
+        for (size_t i = 0; i < count; i++)
+            data[i] = (T)((int64_t)low + (int64_t)(rng() % (uint64_t)((int64_t)high - (int64_t)low + 1)));
+        T probe = count > 0 ? data[count - 1] : low;
+        ok = ok && listsimd<T>::find(data, count, probe) == listsimd<T, false>::find(data, count, probe);
+        ok = ok && listsimd<T>::find(data, count, (T)(high + 1)) == count;
+        for (thresholdop op : ops)
+            ok = ok && listsimd<T>::countIf(data, count, op, probe) == listsimd<T, false>::countIf(data, count, op, probe);
+        ok = ok && listsimd<T>::sum(data, count) == listsimd<T, false>::sum(data, count);
+        if (count > 0)
+        {
+            ok = ok && listsimd<T>::min(data, count) == listsimd<T, false>::min(data, count);
+            ok = ok && listsimd<T>::max(data, count) == listsimd<T, false>::max(data, count);
+        }
+    }
+    return ok;
+}
+
+void test_chunked_list()
+{
+    begin_suite("chunkedlist: simd find / countIf / min / max / sum");
+
+    CHECK(simd_matches_scalar<int32_t>(-40, 40));
+    CHECK(simd_matches_scalar<int32_t>(-2000000000, 2000000000)); // int64 sums
+    CHECK(simd_matches_scalar<int16_t>(-30000, 30000));
+    CHECK(simd_matches_scalar<float>(-64.0f, 64.0f)); // integral values: sums are exact
+    CHECK(simd_matches_scalar<uint8_t>(0, 254));      // scalar only
+
+    chunkedlist<int16_t, 8> list;
+    int16_t result = 0;
+    CHECK(list.find(1) == nullptr);
+    CHECK(list.countIf(THRESHOLD_GREATER, 0) == 0);
+    CHECK(list.min(result) == false && list.max(result) == false);
+    CHECK(list.sum() == 0);
+    CHECK(list.begin() == list.end());
+    CHECK(list.removeAtBeginning() == false);
+
+    for (int i = 0; i < 100; i++)
+        list.insertAtEnd((int16_t)(i % 10 == 9 ? -i : i));
+    CHECK(list.size() == 100 && list.chunks() == 13);
+    for (int i = 0; i < 5; i++)
+        list.removeAtBeginning(); // 5 ... 99, head chunk half used
+    CHECK(list.size() == 95 && list.chunks() == 13);
+    for (int i = 0; i < 3; i++)
+        list.removeAtBeginning(); // 8 ... 99, first chunk freed
+    CHECK(list.size() == 92 && list.chunks() == 12);
+    CHECK(*list.getStoragePtr(1) == 8 && *list.getStoragePtr(2) == -9);
+    CHECK(*list.getStoragePtr(92) == -99 && list.getStoragePtr(93) == nullptr);
+
+    CHECK(list.find(-9) == list.getStoragePtr(2));
+    CHECK(list.find(42) == list.getStoragePtr(35));
+    CHECK(list.find(3) == nullptr);
+    CHECK(list.countIf(THRESHOLD_LESS, 0) == 10);
+    CHECK(list.countIf(THRESHOLD_GREATER_EQUAL, 50) == 45);
+    CHECK(list.countIf(THRESHOLD_EQUAL, 50) == 1);
+    CHECK(list.countIf([](int16_t x) { return x % 2 == 0; }) == 46);
+    CHECK(list.min(result) && result == -99);
+    CHECK(list.max(result) && result == 98);
+
+    int64_t expected = 0;
+    for (int i = 8; i < 100; i++)
+        expected += i % 10 == 9 ? -i : i;
+    CHECK(list.sum() == expected);
+    int64_t walked = 0;
+    size_t visited = 0;
+    for (int16_t x : list)
+    {
+        walked += x;
+        ++visited;
+    }
+    CHECK(walked == expected && visited == 92);
+    CHECK(view(list).filter([](int16_t x) { return x < 0; }).count() == 10);
+
+    while (list.removeAtBeginning()) {}
+    CHECK(list.size() == 0 && list.chunks() == 0);
+    list.insertAtEnd(7);
+    CHECK(list.size() == 1 && *list.find(7) == 7);
+    list.clear();
+    CHECK(list.size() == 0 && list.begin() == list.end());
+
+    chunkedlist<float> samples;
+    for (int i = 0; i < 1000; i++)
+        samples.insertAtEnd(i * 0.5f);
+    float peak = 0.0f;
+    CHECK(samples.max(peak) && peak == 499.5f);
+    CHECK(samples.sum() == 249750.0);
+    CHECK(samples.countIf(THRESHOLD_GREATER, 250.0f) == 499);
+}
+
+// ─── memory accounting tests ──────────────────────────────────────────────────
+
+// Fills a list to 10 nodes, reserves 16 slots, trims to 6 nodes and checks
+// every listmemory field against sizeof at each step
+template <typename List, typename Slot>
+static bool memory_usage_tracks(List &list, size_t inline_nodes)
+{
+    const size_t slot = sizeof(Slot);
+    const size_t payload = sizeof(Vec3);
+    bool ok = true;
+
+    listmemory empty = list.memoryUsage();
+    ok = ok && empty.object == sizeof(List) - inline_nodes * slot;
+    ok = ok && empty.nodes == 0 && empty.payloads == 0 && empty.overhead == 0;
+    ok = ok && empty.unused == inline_nodes * slot;
+
+    for (int i = 0; i < 10; i++)
+        list.insertAtEnd(i, 0, 0);
+    size_t heap = 10 - inline_nodes;
+    listmemory full = list.memoryUsage();
+    ok = ok && full.nodes == 10 * (slot - payload) && full.payloads == 10 * payload;
+    ok = ok && full.unused == 0 && full.overhead == heap * heap_overhead(slot);
+    ok = ok && full.total() == full.object + 10 * slot + heap * heap_overhead(slot);
+
+    list.reserve(16); // 6 spare heap slots
+    list.deleteRange(1, 4); // kept as spares, inline slots freed first
+    listmemory trimmed = list.memoryUsage();
+    ok = ok && trimmed.payloads == 6 * payload;
+    ok = ok && trimmed.unused == 10 * slot; // 16 slots, 6 in use
+    ok = ok && trimmed.overhead == (16 - inline_nodes) * heap_overhead(slot);
+    ok = ok && trimmed.object == empty.object;
+
+    list.shrink_to_fit();
+    ok = ok && list.memoryUsage().unused == (inline_nodes > 0 ? 4 : 0) * slot; // freed inline slots stay
+    return ok;
+}
+
+void test_memory_usage()
+{
+    begin_suite("memoryUsage: nodes / payloads / unused / overhead");
+
+    basic_singlylist<reservetraits, Vec3, int, int, int> singly;
+    CHECK((memory_usage_tracks<basic_singlylist<reservetraits, Vec3, int, int, int>, nodeslot<singlylistnode<Vec3>, Vec3> >(singly, 0)));
+    basic_circulardoublylist<reservetraits, Vec3, int, int, int> circly;
+    CHECK((memory_usage_tracks<basic_circulardoublylist<reservetraits, Vec3, int, int, int>, nodeslot<circlylistnode<Vec3>, Vec3> >(circly, 0)));
+    basic_singlylist<inlinereservetraits, Vec3, int, int, int> small;
+    CHECK((memory_usage_tracks<basic_singlylist<inlinereservetraits, Vec3, int, int, int>, nodeslot<singlylistnode<Vec3>, Vec3> >(small, 4)));
+    basic_circulardoublylist<inlinereservetraits, Vec3, int, int, int> smallcircle;
+    CHECK((memory_usage_tracks<basic_circulardoublylist<inlinereservetraits, Vec3, int, int, int>, nodeslot<circlylistnode<Vec3>, Vec3> >(smallcircle, 4)));
+
+    // the allocator estimate never undercuts a size_t header
+    CHECK(heap_overhead(1) >= sizeof(size_t) && heap_overhead(24) >= sizeof(size_t));
+    CHECK((heap_overhead(24) + 24) % (2 * sizeof(size_t)) == 0);
+}
+
+// ─── slab allocation tests ────────────────────────────────────────────────────
+
+struct tinyslabtraits : listtraits
+{
+    typedef uint8_t size_type;
+    static const uint16_t slab_slots = 200;
+};
+
+void test_slab_lists()
+{
+    begin_suite("slab slots: growth / churn / release / moves");
+
+    typedef basic_singlylist<slabtraits<8>, Vec3, int, int, int> slabsingly;
+    typedef basic_circulardoublylist<slabtraits<8>, Vec3, int, int, int> slabcircle;
+    typedef nodeslot<circlylistnode<Vec3>, Vec3> circleslot;
+
+    {
+        slabsingly list;
+        size_t before = g_heap_allocs;
+        for (int i = 0; i < 8; i++)
+            list.insertAtEnd(i, 0, 0);
+        CHECK(g_heap_allocs == before + 1);  // one slab of 8
+        list.insertAtEnd(8, 0, 0);
+        CHECK(g_heap_allocs == before + 2);  // then one of 16
+        CHECK(list.capacity() == 24);
+
+        before = g_heap_allocs;
+        for (int i = 0; i < 1000; i++)       // steady churn
+        {
+            list.insertAtEnd(i, 0, 0);
+            list.removeAtBeginning();
+        }
+        CHECK(g_heap_allocs == before);
+        CHECK(list.size() == 9 && list.getStoragePtr(9)->x == 999);
+
+        list.clear();
+        CHECK(list.capacity() == 24);        // freed slots stay in their slabs
+        list.shrink_to_fit();
+        CHECK(list.capacity() == 0);
+        CHECK(list.memoryUsage().overhead == 0);
+    }
+
+    {
+        slabcircle list;
+        for (int i = 0; i < 24; i++)
+            list.insertAtEnd(i, 0, 0);
+        CHECK(list.deleteRange(9, 24));      // empties the second slab
+        list.shrink_to_fit();
+        CHECK(list.capacity() == 8 && list.size() == 8);
+        CHECK(list.memoryUsage().unused == 0);
+        CHECK(list.reserve(20));             // one more slab, of 16
+        CHECK(list.capacity() == 24);
+        CHECK(list.memoryUsage().unused == 16 * sizeof(circleslot));
+        for (int i = 0; i < 4; i++)          // taken from the new slab
+            list.insertAtEnd(i, 0, 0);
+        CHECK(list.deleteRange(1, 8));       // empties the first slab
+        list.shrink_to_fit();
+        CHECK(list.capacity() == 16 && list.size() == 4);
+        size_t before = g_heap_allocs;
+        CHECK(list.reserve(16) && list.capacity() == 16);
+        CHECK(g_heap_allocs == before);
+    }
+
+    {
+        slabcircle a;
+        slabcircle b;
+        slabcircle::circlynode *first = a.insertAtEnd(1, 0, 0);
+        a.insertAtEnd(2, 0, 0);
+        b.insertAtEnd(3, 0, 0);
+        CHECK(b.spliceAtEnd(first, a) == false); // slab slots stay in their list
+        CHECK(b.spliceAllAtEnd(a) == false);
+        CHECK(a.spliceAtEnd(first, a) == true);  // rotation is fine
+        CHECK(list_matches(a, {2, 1}));
+
+        a.swap(b);
+        CHECK(list_matches(a, {3}) && list_matches(b, {2, 1}));
+        slabcircle moved(static_cast<slabcircle &&>(b));
+        CHECK(list_matches(moved, {2, 1}) && b.size() == 0);
+        b = static_cast<slabcircle &&>(a);
+        CHECK(list_matches(b, {3}) && a.size() == 0);
+        {
+            slabcircle copy(moved);
+            CHECK(list_matches(copy, {2, 1}));
+        }
+        a.insertAtEnd(4, 0, 0); // a's pool is usable after being moved from
+        CHECK(list_matches(a, {4}));
+    }
+
+    {
+        basic_singlylist<tinyslabtraits, Vec3, int, int, int> tiny;
+        for (int i = 0; i < 255; i++)
+            tiny.insertAtEnd(i, 0, 0);
+        CHECK(tiny.size() == 255 && tiny.capacity() == 255); // second slab cut to 55
+    }
+
+    {
+        basic_singlylist<slabtraits<4>, Counted, int> counted;
+        for (int i = 0; i < 10; i++)
+            counted.insertAtEnd(i);
+        counted.removeAtBeginning();
+        CHECK(Counted::live == 9);
+        counted.clear();
+        CHECK(Counted::live == 0);
+    }
+}
+
+// Relinks a list into a pseudo-random order with rounds of stable partition
+template <typename List>
+static void scramble(List &list, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    for (int round = 0; round < 12; round++)
+        list.partition([&rng](Vec3 &) { return (rng() & 1U) != 0; });
+}
+
+// Checks that compact() keeps the payload order, follows lastnode, and lays
+// the heap nodes out one slot apart in list order
+template <typename List, typename Slot>
+static bool compacts_in_order(List &list, size_t inline_nodes)
+{
+    std::vector<int> order;
+    for (Vec3 &v : list)
+        order.push_back(v.x);
+    list.getStoragePtr((typename List::size_type)(order.size() / 2));
+    int last_x = list.getLastAccessedNode()->sp->x;
+
+    size_t before = g_heap_allocs;
+    bool ok = list.compact();
+    ok = ok && g_heap_allocs == before + (order.size() > inline_nodes ? 1 : 0);
+    ok = ok && (size_t)list.capacity() == (order.size() > inline_nodes ? order.size() : inline_nodes);
+    ok = ok && list.getLastAccessedNode()->sp->x == last_x;
+
+    size_t i = 0;
+    const unsigned char *object = reinterpret_cast<const unsigned char *>(&list);
+    const unsigned char *previous = nullptr;
+    for (auto it = list.begin(); it != list.end(); ++it, ++i)
+    {
+        ok = ok && i < order.size() && it->x == order[i];
+        const unsigned char *at = reinterpret_cast<const unsigned char *>(it.node());
+        if (at < object || at >= object + sizeof(List)) // inline slots stay put
+        {
+            ok = ok && (previous == nullptr || at == previous + sizeof(Slot));
+            previous = at;
+        }
+    }
+    return ok && i == order.size();
+}
+
+struct inlineslabtraits : listtraits
+{
+    static const uint8_t inline_nodes = 3;
+    static const uint16_t slab_slots = 4;
+};
+
+void test_compact()
+{
+    begin_suite("compact(): list-order relocation into one slab");
+
+    typedef basic_singlylist<slabtraits<8>, Vec3, int, int, int> slabsingly;
+    typedef basic_circulardoublylist<slabtraits<8>, Vec3, int, int, int> slabcircle;
+    typedef basic_circulardoublylist<inlineslabtraits, Vec3, int, int, int> mixedcircle;
+    typedef nodeslot<singlylistnode<Vec3>, Vec3> singlyslot;
+    typedef nodeslot<circlylistnode<Vec3>, Vec3> circleslot;
+
+    slabsingly singly;
+    CHECK(singly.compact());                 // empty
+    for (int i = 0; i < 300; i++)
+        singly.insertAtEnd(i, 0, 0);
+    scramble(singly, 1);
+    singly.reserve(400);                     // spares are dropped
+    CHECK((compacts_in_order<slabsingly, singlyslot>(singly, 0)));
+    CHECK(singly.memoryUsage().unused == 0);
+    CHECK(singly.insertAtEnd(300, 0, 0) != nullptr && singly.size() == 301);
+    CHECK(singly.getStoragePtr(301)->x == 300);
+
+    slabcircle circle;
+    for (int i = 0; i < 300; i++)
+        circle.insertAtEnd(i, 0, 0);
+    scramble(circle, 2);
+    circle.deleteRange(10, 40);
+    CHECK((compacts_in_order<slabcircle, circleslot>(circle, 0)));
+    bool links = true;
+    slabcircle::circlynode *first = circle.begin().node();
+    slabcircle::circlynode *node = first;
+    for (int i = 0; i < circle.size(); i++, node = node->n)
+        links = links && node->n->p == node;
+    CHECK(links && node == first);
+    CHECK(circle.getStoragePtr(circle.size())->x == first->p->sp->x);
+
+    mixedcircle mixed;
+    for (int i = 0; i < 20; i++)
+        mixed.insertAtEnd(i, 0, 0);
+    scramble(mixed, 3);
+    mixed.deleteRange(1, 2);
+    CHECK((compacts_in_order<mixedcircle, circleslot>(mixed, 3)));
+
+    basic_singlylist<slabtraits<4>, Counted, int> counted;
+    for (int i = 0; i < 50; i++)
+        counted.insertAtBeginning(i);
+    CHECK(counted.compact() && Counted::live == 50);
+    CHECK(counted.getStoragePtr(1)->x == 49 && counted.getStoragePtr(50)->x == 0);
+    counted.clear();
+    CHECK(Counted::live == 0);
+}
+
+// ─── intrusive list tests ─────────────────────────────────────────────────────
+
+struct Device // lives in a static array, on up to three lists at once
+{
+    int id;
+    singlyhook<Device> pending;
+    circlyhook<Device> bybus;
+    circlyhook<Device> byidle;
+};
+
+template <typename List>
+static bool ids_match(const List &list, std::initializer_list<int> expected)
+{
+    if (list.size() != expected.size())
+        return false;
+    const int *want = expected.begin();
+    for (Device &d : list)
+        if (d.id != *want++)
+            return false;
+    return true;
+}
+
+void test_intrusive_lists()
+{
+    begin_suite("intrusive lists: hooks / multi-list membership");
+
+    static Device devices[6];
+    for (int i = 0; i < 6; i++)
+        devices[i].id = i;
+
+    size_t before = g_heap_allocs;
+    {
+        intrusivesinglylist<Device, &Device::pending> pending;
+        intrusivecircularlist<Device, &Device::bybus> bus;
+        intrusivecircularlist<Device, &Device::byidle> idle;
+        for (int i = 0; i < 6; i++)
+        {
+            pending.linkAtEnd(devices[i]);
+            CHECK(bus.linkAtBeginning(devices[i]));
+            if (i % 2 == 0)
+                idle.linkAtEnd(devices[i]);
+        }
+        CHECK(ids_match(pending, {0, 1, 2, 3, 4, 5}));
+        CHECK(ids_match(bus, {5, 4, 3, 2, 1, 0}));
+        CHECK(ids_match(idle, {0, 2, 4}));
+        CHECK(bus.linkAtEnd(devices[3]) == false); // already linked through bybus
+        CHECK(devices[3].bybus.isLinked() && !devices[3].byidle.isLinked());
+
+        // O(1) unlink through the object; the other lists are untouched
+        CHECK(bus.unlink(devices[2]) && !devices[2].bybus.isLinked());
+        CHECK(bus.unlink(devices[2]) == false);
+        CHECK(idle.unlink(devices[0]));
+        CHECK(ids_match(bus, {5, 4, 3, 1, 0}));
+        CHECK(ids_match(idle, {2, 4}));
+        CHECK(ids_match(pending, {0, 1, 2, 3, 4, 5}));
+
+        CHECK(pending.unlink(devices[5]) && pending.back() == &devices[4]);
+        CHECK(pending.unlink(devices[0]) && pending.front() == &devices[1]);
+        CHECK(pending.unlink(devices[0]) == false);
+        pending.linkAfter(devices[2], devices[5]);
+        CHECK(ids_match(pending, {1, 2, 5, 3, 4}));
+        CHECK(pending.removeIf([](Device &d) { return d.id % 2 == 1; }) == 3);
+        CHECK(ids_match(pending, {2, 4}) && pending.back() == &devices[4]);
+        CHECK(pending.removeAtBeginning() == &devices[2]);
+
+        CHECK(bus.getStoragePtr(1) == &devices[5] && bus.getStoragePtr(5) == &devices[0]);
+        CHECK(bus.getStoragePtr(4) == &devices[1] && bus.getStoragePtr(6) == nullptr);
+        CHECK(bus.removeAtEnd() == &devices[0] && bus.removeAtBeginning() == &devices[5]);
+        CHECK(bus.linkAfter(devices[4], devices[2]));
+        CHECK(ids_match(bus, {4, 2, 3, 1}));
+        int reversed[4];
+        int count = 0;
+        for (Device &d : view(bus).reverse())
+            reversed[count++] = d.id;
+        CHECK(count == 4 && reversed[0] == 1 && reversed[3] == 4);
+        CHECK(bus.removeIf([](Device &d) { return d.id > 1; }) == 3);
+        CHECK(ids_match(bus, {1}) && bus.front() == bus.back());
+        CHECK(view(idle).map([](Device &d) { return d.id; }).fold(0, [](int a, int b) { return a + b; }) == 6);
+
+        // copies start unlinked and assignment keeps the target's links
+        Device copy = devices[4];
+        CHECK(!copy.bybus.isLinked() && !copy.byidle.isLinked() && copy.pending.n == nullptr);
+        devices[4] = devices[1];
+        CHECK(devices[4].byidle.isLinked() && ids_match(idle, {2, 1}) && pending.front() == &devices[4]);
+        devices[4].id = 4;
+    } // destructors unlink everything
+    CHECK(g_heap_allocs == before);
+    bool unlinked = true;
+    for (Device &d : devices)
+        unlinked = unlinked && !d.bybus.isLinked() && !d.byidle.isLinked() && d.pending.n == nullptr;
+    CHECK(unlinked);
+}
+
+// ─── handle list tests ────────────────────────────────────────────────────────
+
+template <typename List>
+static bool xs_match(List &list, std::initializer_list<int> expected)
+{
+    if (list.size() != expected.size())
+        return false;
+    const int *want = expected.begin();
+    for (Vec3 &v : list)
+        if (v.x != *want++)
+            return false;
+    return true;
+}
+
+void test_handle_list()
+{
+    begin_suite("handlelist: generation-checked handles");
+
+    size_t before = g_heap_allocs;
+    {
+        handlelist<Vec3, 4, int, int, int> list;
+        CHECK(list.size() == 0 && list.capacity() == 4);
+        CHECK(list.front().isNull() && list.back().isNull());
+        CHECK(list.get(listhandle()) == nullptr && !list.erase(listhandle()));
+
+        listhandle a = list.insertAtEnd(1, 0, 0);
+        listhandle b = list.insertAtEnd(2, 0, 0);
+        listhandle c = list.insertAtBeginning(3, 0, 0);
+        listhandle d = list.insertAfter(a, 4, 0, 0);
+        CHECK(!a.isNull() && !b.isNull() && !c.isNull() && !d.isNull());
+        CHECK(xs_match(list, {3, 1, 4, 2}));
+        CHECK(list.front() == c && list.back() == b);
+        CHECK(list.get(d)->x == 4 && list.contains(a));
+        CHECK(list.insertAtEnd(5, 0, 0).isNull()); // full
+
+        // erasing makes the handle stale, and reuse of its slot does not revive it
+        Vec3 *stable = list.get(b);
+        CHECK(list.erase(a) && !list.contains(a) && list.get(a) == nullptr);
+        CHECK(list.erase(a) == false && list.insertAfter(a, 9, 0, 0).isNull());
+        CHECK(list.get(b) == stable);
+        listhandle e = list.insertAtEnd(5, 0, 0);
+        CHECK(e.index == a.index && e != a);
+        CHECK(list.get(a) == nullptr && list.get(e)->x == 5);
+        CHECK(xs_match(list, {3, 4, 2, 5}));
+
+        CHECK(list.erase(b) && list.erase(c) && list.back() == e && list.front() == d);
+        CHECK(list.removeAtBeginning() && list.front() == e && !list.contains(d));
+        int seen = 0;
+        for (handlelist<Vec3, 4, int, int, int>::iterator it = list.begin(); it != list.end(); ++it)
+            seen += it.handle() == e;
+        CHECK(seen == 1);
+        list.clear();
+        CHECK(list.size() == 0 && !list.contains(e) && !list.removeAtBeginning());
+        CHECK(list.front().isNull() && list.begin() == list.end());
+    }
+    CHECK(g_heap_allocs == before); // slots live in the object
+
+    {
+        // generations survive many reuses of a one-slot list
+        handlelist<Counted, 1, int> one;
+        listhandle first = one.insertAtEnd(0);
+        one.erase(first);
+        listhandle last;
+        bool fresh = true;
+        for (int i = 1; i <= 40000; i++)
+        {
+            last = one.insertAtEnd(i);
+            fresh = fresh && !last.isNull() && !one.contains(first) && one.get(last)->x == i;
+            one.removeAtBeginning();
+        }
+        CHECK(fresh && Counted::live == 0);
+        last = one.insertAtEnd(7);
+        CHECK(one.get(last)->x == 7 && Counted::live == 1);
+    }
+    CHECK(Counted::live == 0);
+
+    {
+        // larger capacities use 16-bit slot indices
+        static handlelist<int, 300, int> wide;
+        listhandle handles[300];
+        for (int i = 0; i < 300; i++)
+            handles[i] = wide.insertAtEnd(i);
+        CHECK(wide.size() == 300 && wide.insertAtEnd(300).isNull());
+        CHECK(*wide.get(handles[299]) == 299 && handles[299].index == 299);
+        for (int i = 0; i < 300; i += 2)
+            wide.erase(handles[i]);
+        bool odd_left = wide.size() == 150;
+        for (int i = 0; i < 300; i++)
+            odd_left = odd_left && (wide.get(handles[i]) != nullptr) == (i % 2 == 1);
+        CHECK(odd_left && *wide.get(wide.front()) == 1 && *wide.get(wide.back()) == 299);
+        wide.clear();
+    }
+
+    // singlylist's one remembered node, lastnode, never outlives its node:
+    // every delete that frees it clears it or moves it to a live node
+    bool live = true;
+    for (int path = 0; path < 5; path++)
+    {
+        singlylist<Vec3, int, int, int> plain;
+        for (int i = 1; i <= 3; i++)
+            plain.insertAtEnd(i, 0, 0);
+        int at = path == 0 || path == 1 ? 1 : path == 2 ? 2 : 3;
+        plain.getStoragePtr(at);
+        if (path == 0)
+            plain.removeAtBeginning();
+        else if (path == 4)
+            plain.deleteRange(at, 3);
+        else
+            plain.deleteFromPosition(at);
+        bool found = plain.getLastAccessedNode() == nullptr;
+        for (auto it = plain.begin(); it != plain.end(); ++it)
+            found = found || it.node() == plain.getLastAccessedNode();
+        live = live && found;
+    }
+    CHECK(live);
+}
+
+// ─── bloom filter tests ───────────────────────────────────────────────────────
+
+struct vec3byx // bloomlist key policy: Vec3 payloads looked up by x
+{
+    typedef int key_type;
+    static int key(const Vec3 &v) { return v.x; }
+    static uint32_t hash(int x) { return (uint32_t)x; }
+};
+
+// true if mayContain rejects every key in [from, to)
+template <typename List>
+static bool rejects_all(const List &list, int from, int to)
+{
+    for (int key = from; key < to; key++)
+        if (list.mayContain(key))
+            return false;
+    return true;
+}
+
+void test_bloom_list()
+{
+    begin_suite("bloomlist: counting Bloom filter membership");
+
+    countingbloom<16, 2> tiny;
+    for (int i = 0; i < 20; i++)
+        tiny.add(7U);
+    for (int i = 0; i < 20; i++)
+        tiny.remove(7U);
+    CHECK(tiny.mayContain(7U)); // saturated counters stick: no false negative
+    tiny.clear();
+    CHECK(!tiny.mayContain(7U));
+
+    typedef bloomlist<singlylist<Vec3, int, int, int>, vec3byx, 1024> singlybloom;
+    singlybloom list;
+    CHECK(sizeof(list) == sizeof(singlylist<Vec3, int, int, int>) + 512);
+    CHECK(rejects_all(list, -50, 50) && !list.contains(3));
+    for (int i = 0; i < 100; i++)
+        list.insertAtEnd(i * 2, 0, 0);
+    bool present = true;
+    for (int i = 0; i < 100; i++)
+        present = present && list.mayContain(i * 2) && list.contains(i * 2);
+    CHECK(present);
+    int false_positives = 0;
+    for (int i = 0; i < 1000; i++)
+        false_positives += list.mayContain(i * 2 + 1) ? 1 : 0;
+    CHECK(false_positives < 60); // about 2.5 % expected with 10 counters per node
+    CHECK(list.find(40)->x == 40 && list.find(41) == nullptr);
+
+    // every delete path uncounts what it removes
+    CHECK(list.deleteFromPosition(1) && !list.mayContain(0));
+    list.removeAtBeginning();
+    CHECK(!list.mayContain(2) && list.contains(4));
+    CHECK(list.deleteRange(1, 3) && rejects_all(list, 4, 10) && list.contains(10));
+    CHECK(list.removeIf([](Vec3 &v) { return v.x >= 100; }) == 50);
+    CHECK(list.contains(98) && !list.mayContain(100) && !list.mayContain(198));
+    list.insertAtPosition(2, 10, 1, 0);
+    list.insertCopyAtEnd(Vec3{98, 1, 0});
+    CHECK(list.unique([](Vec3 &a, Vec3 &b) { return a.x == b.x; }) == 2);
+    CHECK(list.contains(10) && list.contains(98) && list.size() == 45);
+    Vec3 more[3] = {{500, 0, 0}, {501, 0, 0}, {502, 0, 0}};
+    CHECK(list.fromArray(more, 3) == 3 && list.contains(501));
+
+    singlybloom moved(static_cast<singlybloom &&>(list));
+    CHECK(list.size() == 0 && rejects_all(list, 0, 600) && moved.contains(502));
+    singlybloom copy = moved;
+    copy.deleteFromPosition(1);
+    CHECK(!copy.mayContain(10) && moved.contains(10));
+    copy.swap(moved);
+    CHECK(copy.contains(10) && !moved.mayContain(10));
+    copy.getStoragePtr(1)->x = 7; // key changed in place
+    copy.rebuild();
+    CHECK(copy.contains(7) && !copy.mayContain(10));
+    copy.clear();
+    CHECK(rejects_all(copy, 0, 600));
+
+    // circular: deleteNode and splices update both filters
+    typedef bloomlist<circulardoublylist<Vec3, int, int, int>, vec3byx> circlybloom;
+    circlybloom a, b;
+    circulardoublylist<Vec3, int, int, int> plain;
+    circlybloom::circlynode *nodes[4];
+    for (int i = 1; i <= 4; i++)
+        nodes[i - 1] = a.insertAtEnd(i, 0, 0);
+    plain.insertAtEnd(9, 0, 0);
+    CHECK(a.deleteNode(nodes[1]) && !a.mayContain(2));
+    CHECK(b.spliceAtEnd(nodes[0], a) && b.contains(1) && !a.mayContain(1));
+    CHECK(b.spliceAllAtEnd(a) && list_matches(b, {1, 3, 4}) && rejects_all(a, 0, 10));
+    CHECK(b.contains(3) && b.contains(4));
+    CHECK(b.spliceAtEnd(plain.begin().node(), plain) && b.contains(9));
+    CHECK(b.removeIf([](Vec3 &v) { return v.x != 4; }) == 3);
+    CHECK(list_matches(b, {4}) && rejects_all(b, 0, 4) && rejects_all(b, 5, 10));
+}
+
+// ─── augmented list tests ─────────────────────────────────────────────────────
+
+// true if the O(1) sum, count, min and max agree with a walk of the list
+template <typename List>
+static bool aggregates_match(List &list)
+{
+    long long sum = 0;
+    int lo = 0, hi = 0;
+    size_t count = 0;
+    for (Vec3 &v : list)
+    {
+        lo = count == 0 || v.x < lo ? v.x : lo;
+        hi = count == 0 || v.x > hi ? v.x : hi;
+        sum += v.x;
+        count++;
+    }
+    int got_lo = -1, got_hi = -1;
+    bool extremes = count == 0 ? !list.min(got_lo) && !list.max(got_hi)
+                               : list.min(got_lo) && list.max(got_hi) && got_lo == lo && got_hi == hi;
+    return extremes && list.aggregate().sum == sum && list.aggregate().count == count;
+}
+
+void test_augmented_list()
+{
+    begin_suite("augmentedlist / extremalist: O(1) aggregates and min / max");
+
+    typedef augmentedlist<singlylist<Vec3, int, int, int>, sumaggregate<vec3byx>> summed;
+    summed readings;
+    CHECK(readings.aggregate().count == 0 && readings.aggregate().mean() == 0.0);
+    for (int i = 1; i <= 4; i++)
+        readings.insertAtEnd(i * 10, 0, 0);
+    CHECK(readings.aggregate().sum == 100 && readings.aggregate().mean() == 25.0);
+    readings.removeAtBeginning();
+    readings.insertAtPosition(2, 5, 0, 0);
+    CHECK(readings.aggregate().sum == 95 && readings.aggregate().count == 4);
+    CHECK(readings.removeIf([](Vec3 &v) { return v.x < 25; }) == 2 && readings.aggregate().sum == 70);
+    readings.getStoragePtr(1)->x = 1; // changed in place
+    readings.rebuild();
+    CHECK(readings.aggregate().sum == 41);
+    summed moved(static_cast<summed &&>(readings));
+    CHECK(moved.aggregate().sum == 41 && readings.aggregate().count == 0);
+    moved.clear();
+    CHECK(moved.aggregate().sum == 0 && moved.aggregate().count == 0);
+
+    augmentedlist<basic_singlylist<sizetraits<uint8_t>, Vec3, int, int, int>, sumaggregate<vec3byx>> full;
+    for (int i = 1; i <= 255; i++)
+        full.insertAtEnd(i, 0, 0);
+    CHECK(full.deleteRange(2, full.size()) && full.aggregate().sum == 1 && full.aggregate().count == 1);
+
+    // nested: both wrappers see every change
+    typedef extremalist<augmentedlist<circulardoublylist<Vec3, int, int, int>, sumaggregate<vec3byx>>, vec3byx> window;
+    window w;
+    CHECK(aggregates_match(w));
+    int samples[12] = {5, 3, 8, 3, 9, 1, 7, 7, 2, 6, 4, 9};
+    bool sliding = true;
+    for (int i = 0; i < 12; i++) // sliding window of 4: append at the tail, drop the head
+    {
+        w.insertAtEnd(samples[i], 0, 0);
+        if (w.size() > 4)
+            w.deleteFromPosition(1);
+        sliding = sliding && aggregates_match(w);
+    }
+    CHECK(sliding && list_matches(w, {2, 6, 4, 9}));
+    for (int i = 0; i < 12; i++) // the same window, overwriting the head in place
+        w.insertAtEndBounded(4, samples[i], 0, 0);
+    CHECK(aggregates_match(w) && list_matches(w, {2, 6, 4, 9}));
+    w.insertAtBeginning(0, 0, 0);
+    w.insertAtBeginning(11, 0, 0);
+    CHECK(aggregates_match(w));
+    CHECK(w.deleteFromPosition(w.size()) && aggregates_match(w)); // tail delete rebuilds lazily
+    CHECK(w.deleteFromPosition(3) && w.deleteFromPosition(2) && aggregates_match(w));
+    w.insertAtPosition(2, -4, 0, 0);
+    w.insertAtPosition(2, 3, 0, 0);
+    CHECK(aggregates_match(w) && list_matches(w, {11, 3, -4, 6, 4}));
+    CHECK(w.deleteRange(2, 3) && aggregates_match(w));
+
+    // random mix of every edge against a walk
+    unsigned seed = 12345U;
+    bool mixed = true;
+    for (int step = 0; step < 2000; step++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        int value = (int)((seed >> 8) % 50U) - 25;
+        unsigned op = (seed >> 20) % 7U;
+        if (op < 2 || w.size() == 0)
+            w.insertAtEnd(value, 0, 0);
+        else if (op == 2)
+            w.insertAtBeginning(value, 0, 0);
+        else if (op == 3)
+            w.insertAtPosition(1 + (seed >> 4) % w.size(), value, 0, 0);
+        else if (op == 4)
+            w.deleteFromPosition(1);
+        else if (op == 5)
+            w.deleteFromPosition(w.size());
+        else
+            w.deleteFromPosition(1 + (seed >> 4) % w.size());
+        mixed = mixed && aggregates_match(w);
+    }
+    CHECK(mixed);
+    // reordering leaves the wedges stale, not wrong
+    window r;
+    for (int i = 1; i <= 3; i++)
+        r.insertAtEnd(i, 0, 0);
+    r.reverse();
+    CHECK(r.deleteFromPosition(1) && aggregates_match(r) && list_matches(r, {2, 1}));
+    int extreme = 0;
+    r.clear();
+    r.insertAtEnd(5, 0, 0);
+    r.insertAtEnd(1, 0, 0);
+    r.insertAtEnd(9, 0, 0);
+    r.partition([](Vec3 &v) { return v.x == 9; });
+    CHECK(r.deleteFromPosition(1) && r.max(extreme) && extreme == 5 && aggregates_match(r));
+    circulardoublylist<Vec3, int, int, int> plain;
+    plain.insertAtEnd(-7, 0, 0);
+    plain.insertAtEnd(30, 0, 0);
+    r.swap(plain);
+    CHECK(aggregates_match(r) && r.aggregate().sum == 23 && list_matches(plain, {5, 1}));
+    r = plain;
+    CHECK(aggregates_match(r) && r.aggregate().sum == 6);
+    r = static_cast<circulardoublylist<Vec3, int, int, int> &&>(plain);
+    CHECK(aggregates_match(r) && plain.size() == 0);
+
+    window copy = w;
+    copy.swap(w);
+    CHECK(aggregates_match(copy) && aggregates_match(w));
+    w.clear();
+    CHECK(aggregates_match(w));
+}
+
+// ─── channel tests (C++20) ────────────────────────────────────────────────────
+
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+
+static listtask consume(listchannel<int> &ch, std::vector<int> &got)
+{
+    while (std::optional<int> item = co_await ch.receive())
+        got.push_back(*item);
+    got.push_back(-1); // closed and drained
+}
+
+static listtask produce(listchannel<int> &ch, int first, int count, std::vector<int> &log)
+{
+    for (int i = first; i < first + count; i++)
+    {
+        bool sent = co_await ch.send(i);
+        log.push_back(sent ? i : -i);
+    }
+}
+
+static listtask consume_batches(listchannel<int> &ch, std::vector<size_t> &batches, std::vector<int> &got)
+{
+    int buffer[4];
+    while (size_t n = co_await ch.receive(buffer, 4))
+    {
+        batches.push_back(n);
+        got.insert(got.end(), buffer, buffer + n);
+    }
+}
+
+void test_channel()
+{
+    begin_suite("listchannel: coroutine send / receive");
+
+    {
+        // receivers suspend on an empty channel and are woken by trySend
+        listexecutor ex;
+        listchannel<int> ch(ex);
+        std::vector<int> got;
+        ex.spawn(consume(ch, got));
+        CHECK(ex.run() == 1 && got.empty() && ex.pending() == 0);
+        CHECK(ch.trySend(1) && ex.pending() == 1 && ch.size() == 0); // handed over directly
+        CHECK(ch.trySend(2) && ch.trySend(3) && ch.size() == 2);
+        CHECK(ex.run() == 1);
+        CHECK(got == std::vector<int>({1, 2, 3}) && ch.size() == 0);
+        ch.close();
+        CHECK(ex.run() == 1 && got.back() == -1);
+        CHECK(!ch.trySend(4) && ch.isClosed());
+    }
+
+    {
+        // a bounded channel suspends senders until a receive makes room
+        listexecutor ex;
+        listchannel<int> ch(ex, 2);
+        std::vector<int> sent, got;
+        ex.spawn(produce(ch, 1, 5, sent));
+        ex.run();
+        CHECK(sent == std::vector<int>({1, 2}) && ch.size() == 2 && !ch.trySend(9));
+        size_t before = g_heap_allocs;
+        CHECK(*ch.tryReceive() == 1 && ch.size() == 2); // the waiting sender filled the room
+        CHECK(g_heap_allocs == before);                  // reserved up front
+        ex.spawn(consume(ch, got));
+        ex.run();
+        CHECK(got == std::vector<int>({2, 3, 4, 5}));
+        CHECK(sent == std::vector<int>({1, 2, 3, 4, 5}));
+        CHECK(!ch.tryReceive().has_value());
+
+        // a send finds the consumer waiting and hands the item over
+        std::vector<int> late;
+        ex.spawn(produce(ch, 10, 1, late));
+        ex.run();
+        CHECK(got.back() == 10 && late == std::vector<int>({10}) && ch.size() == 0);
+        ch.close();
+        ex.run();
+        CHECK(got.back() == -1);
+    }
+
+    {
+        // close() fails the waiting and later sends; receivers still drain the queue
+        listexecutor ex;
+        listchannel<int> ch(ex, 1);
+        std::vector<int> sent, left;
+        ex.spawn(produce(ch, 20, 3, sent));
+        ex.run();
+        CHECK(sent == std::vector<int>({20}) && ch.size() == 1);
+        ch.close();
+        ex.run();
+        CHECK(sent == std::vector<int>({20, -21, -22}));
+        ex.spawn(consume(ch, left));
+        ex.run();
+        CHECK(left == std::vector<int>({20, -1}));
+    }
+
+    {
+        // batch receive takes up to n queued items per resume
+        listexecutor ex;
+        listchannel<int> ch(ex);
+        std::vector<size_t> batches;
+        std::vector<int> got, sent;
+        ex.spawn(consume_batches(ch, batches, got));
+        ex.run();
+        for (int i = 1; i <= 6; i++)
+            ch.trySend(i);
+        ex.run();
+        CHECK(batches == std::vector<size_t>({4, 2}) && got.size() == 6 && got[5] == 6);
+        ex.spawn(produce(ch, 7, 9, sent));
+        ex.run();
+        CHECK(got.size() == 15 && got.back() == 15 && batches.size() >= 3);
+        ch.close();
+        ex.run();
+        CHECK(sent.size() == 9 && ch.size() == 0);
+    }
+
+    {
+        // frames never resumed are freed by the executor and the task
+        listexecutor ex;
+        listchannel<int> ch(ex);
+        std::vector<int> got;
+        ex.spawn(consume(ch, got));
+        listtask unspawned = consume(ch, got);
+        CHECK(ex.pending() == 1);
+    }
+}
+
+#endif // __cpp_impl_coroutine
+
+// ─── trace recording tests ────────────────────────────────────────────────────
+
+struct MemorySink
+{
+    std::vector<uint8_t> bytes;
+    size_t write(const uint8_t *data, size_t count)
+    {
+        bytes.insert(bytes.end(), data, data + count);
+        return count;
+    }
+};
+
+void test_trace_recording()
+{
+    begin_suite("tracedlist: recording and decoding");
+
+    MemorySink sink;
+    tracedlist<singlylist<Vec3, int, int, int>, MemorySink> list(sink);
+    CHECK(sink.bytes.empty()); // header is written lazily
+
+    list.insertAtEnd(1, 0, 0);
+    list.insertAtBeginning(0, 0, 0);
+    CHECK(list.insertAtPosition(2, 5, 0, 0) != nullptr);
+    CHECK(list.getStoragePtr(2)->x == 5);   // wrapped calls still work
+    CHECK(list.getNode(300)        == nullptr);
+    CHECK(list.deleteFromPosition(1) == true);
+    list.removeAtBeginning();
+    list.clear();
+    CHECK(list.size() == 0);
+
+    const uint8_t expected[] = {'T', 'L', 'T', 2,
+                                'E', 'B', 'I', 2, 'G', 2,
+                                'N', 0xAC, 0x02, // 300 as a two-byte varint
+                                'D', 1, 'R', 'C'};
+    CHECK(sink.bytes.size() == sizeof(expected));
+    CHECK(memcmp(sink.bytes.data(), expected, sizeof(expected)) == 0);
+
+    tracereader reader(sink.bytes.data(), sink.bytes.size());
+    CHECK(reader.isValid());
+    tracerecord rec;
+    const uint8_t ops[] = {'E', 'B', 'I', 'G', 'N', 'D', 'R', 'C'};
+    const uint32_t positions[] = {0, 0, 2, 2, 300, 1, 0, 0};
+    bool ok = true;
+    for (size_t i = 0; i < sizeof(ops); i++)
+        ok = ok && reader.next(rec) && rec.op == ops[i] && rec.position == positions[i];
+    CHECK(ok);
+    CHECK(reader.next(rec) == false);
+
+    // Truncated varint and bad header are rejected
+    tracereader truncated(sink.bytes.data(), 12);
+    for (int i = 0; i < 6; i++)
+        truncated.next(rec);
+    CHECK(truncated.isValid() == false);
+    const uint8_t bad[] = {'X', 'L', 'T', 1, 'E'};
+    tracereader wrong(bad, sizeof(bad));
+    CHECK(wrong.isValid()     == false);
+    CHECK(wrong.next(rec)     == false);
+    const uint8_t future[] = {'T', 'L', 'T', 3, 'E'};
+    CHECK(tracereader(future, sizeof(future)).isValid() == false);
+    const uint8_t version1[] = {'T', 'L', 'T', 1, 'E', 'D', 1};
+    tracereader old(version1, sizeof(version1));
+    CHECK(old.isValid() && old.next(rec) && rec.op == TRACE_INSERT_END);
+    CHECK(old.next(rec) && rec.op == TRACE_DELETE_POSITION && rec.position == 1);
+
+    // Circular lists record through the same wrapper
+    MemorySink dsink;
+    tracedlist<circulardoublylist<Vec3, int, int, int>, MemorySink> dlist(dsink);
+    dlist.insertAtEnd(1, 0, 0);
+    dlist.deleteFromPosition(1);
+    CHECK(dsink.bytes.size() == 4 + 3);
+}
+
+static bool trace_odd(const Vec3 &v) { return v.x % 2 != 0; }
+static bool trace_same(const Vec3 &a, const Vec3 &b) { return a.x == b.x; }
+
+void test_trace_bulk_operations()
+{
+    begin_suite("tracedlist: bulk, predicate and bounded operations");
+
+    MemorySink sink;
+    tracedlist<circulardoublylist<Vec3, int, int, int>, MemorySink> list(sink);
+    const Vec3 values[] = {{1, 0, 0}, {2, 0, 0}, {2, 0, 0}, {3, 0, 0}, {4, 0, 0}, {5, 0, 0}};
+    CHECK(list.fromArray(values, 6) == 6);
+    CHECK(list.unique(trace_same) == 1);            // drops position 3
+    CHECK(list.removeIf(trace_odd) == 3);           // {1, 2, 3, 4, 5}: positions 1, 3, 5
+    CHECK(list.size() == 2);
+    CHECK(list.insertCopyAtEnd(values[3]) != nullptr);
+    CHECK(list.partition(trace_odd) != nullptr);    // {2, 4, 3}: position 3 goes first
+    CHECK(list.getStoragePtr(1)->x == 3);
+    list.reverse();
+    CHECK(list.insertAtEndBounded(3, 9, 0, 0) != nullptr);
+    CHECK(list.deleteRange(1, 200) == false);       // out of range, still recorded
+    CHECK(list.deleteRange(2, 3) == true);
+    CHECK(list.size() == 1 && list.begin()->x == 2);
+
+    const uint8_t expected[] = {'T', 'L', 'T', 2,
+                                'A', 6,
+                                'M', 3, 'U',
+                                'M', 1, 'M', 3, 'M', 5, 'F',
+                                'Y',
+                                'M', 3, 'P',
+                                'G', 1,
+                                'V',
+                                'W', 3,
+                                'X', 1, 0xC8, 0x01, // 200 as a two-byte varint
+                                'X', 2, 3};
+    CHECK(sink.bytes.size() == sizeof(expected));
+    CHECK(memcmp(sink.bytes.data(), expected, sizeof(expected)) == 0);
+
+    tracereader reader(sink.bytes.data(), sink.bytes.size());
+    tracerecord rec;
+    size_t records = 0;
+    bool ranges = true;
+    while (reader.next(rec))
+    {
+        records++;
+        if (rec.op == TRACE_DELETE_RANGE)
+            ranges = ranges && (rec.last == 200 || (rec.position == 2 && rec.last == 3));
+        else
+            ranges = ranges && rec.last == 0;
+    }
+    CHECK(reader.isValid());
+    CHECK(records == 15);
+    CHECK(ranges);
+    tracereader cut(sink.bytes.data(), sizeof(expected) - 1); // last record loses its last position
+    while (cut.next(rec)) {}
+    CHECK(cut.isValid() == false);
+
+    // Singly lists record the same operations; insertAtEndBounded is circular only
+    MemorySink ssink;
+    tracedlist<singlylist<Vec3, int, int, int>, MemorySink> slist(ssink);
+    slist.fromArray(values, 3);
+    slist.unique(trace_same);
+    slist.reverse();
+    const uint8_t sexpected[] = {'T', 'L', 'T', 2, 'A', 3, 'M', 3, 'U', 'V'};
+    CHECK(ssink.bytes.size() == sizeof(sexpected));
+    CHECK(memcmp(ssink.bytes.data(), sexpected, sizeof(sexpected)) == 0);
+}
+
 // ─── main ─────────────────────────────────────────────────────────────────────
 
 int main()
@@ -699,6 +3057,86 @@ int main()
     test_cdl_clear();
     test_cdl_destructor();
 
+    // staticlist
+    test_static_access();
+    test_static_copy_into();
+
+    // inline node slots
+    test_singly_inline_nodes();
+    test_cdl_inline_nodes();
+
+    // copy / move / swap
+    test_singly_copy_move_swap();
+    test_singly_inline_move();
+    test_cdl_copy_move_swap();
+
+    // iteration / prefetch
+    test_singly_iteration_prefetch();
+    test_cdl_iteration_prefetch();
+
+    // size_type
+    test_small_size_type();
+
+    // trace recording
+    test_trace_recording();
+    test_trace_bulk_operations();
+
+    // reserve
+    test_singly_reserve();
+    test_cdl_reserve();
+
+    // bulk delete
+    test_singly_remove_if_range();
+    test_cdl_remove_if_range();
+
+    // relinking algorithms
+    test_singly_reverse_partition_unique();
+    test_cdl_reverse_partition_unique();
+
+    // views
+    test_views();
+
+    // array export / import
+    test_array_export_import();
+
+    // splice / timer wheel
+    test_cdl_splice();
+    test_cdl_bounded();
+    test_timer_wheel();
+
+    // persistent list
+    test_persistent_list();
+
+    // rcu list
+    test_rcu_list();
+
+    // chunked list
+    test_chunked_list();
+
+    // memory accounting
+    test_memory_usage();
+
+    // slab slots
+    test_slab_lists();
+    test_compact();
+
+    // intrusive lists
+    test_intrusive_lists();
+
+    // handle list
+    test_handle_list();
+
+    // bloom filter
+    test_bloom_list();
+
+    // augmented lists
+    test_augmented_list();
+
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+    // coroutine channel
+    test_channel();
+#endif
+
     std::cout << "\n==============================\n";
     std::cout << "Results: " << g_passed << "/" << g_run << " passed";
     if (g_failed > 0)